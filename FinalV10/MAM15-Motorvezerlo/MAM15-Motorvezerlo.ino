@@ -1,19 +1,58 @@
 #include "settings.h"
+#include "debug_log.h"
 #include "motor_control.h"
 #include "lora_communication.h"
 #include "espnow_communication.h"
 #include "packet_handler.h"
 #include "failsafe.h"
+#include "spsc_ring.h"
+#include "control_timing.h"
+#include "latency_monitor.h"
+#include "link_stats.h"
+#include "adr_controller.h"
+#include "tdma_receiver.h"
+#include "event_channel.h"
 
 // ═════════════════════════════════════════════════════════
 // GLOBÁLIS OBJEKTUMOK
 // ═════════════════════════════════════════════════════════
-MotorControl motors;
+RobotMotorControl motors;
 LoRaCommunication lora;
 ESPNowCommunication espnow;
 PacketHandler packetHandler;
 Failsafe failsafe;
 
+// Rádió task → beavatkozó task csomag gyűrű
+SpscRing<PacketData, PIPELINE_RING_SIZE> packetRing;
+TaskHandle_t radioTaskHandle = nullptr;
+TaskHandle_t actuationTaskHandle = nullptr;
+
+// Link minőség és adaptív adatsebesség (csak a rádió task írja)
+LinkStats linkStats;
+AdrController adr(lora);
+
+// Sebesség váltás számláló egyeztetése (csak a rádió task írja)
+EventReconciler speedEvents;
+
+#if TDMA_ENABLED
+  // Csak a saját időrésben vesz (a rádió task kezeli)
+  TdmaReceiver tdma(lora);
+#endif
+
+// Fix frekvenciájú vezérlési ütem (beavatkozás + failsafe)
+ControlTick controlTick;
+
+#if LATENCY_INSTRUMENTATION
+  // Gomb → PWM késleltetés (csak a beavatkozó task írja)
+  LatencyMonitor latencyMonitor;
+#endif
+
+void radioTask(void* parameter);
+void actuationTask(void* parameter);
+#if DEBUG_ENABLED
+  void handleSerialCommand(char command);
+#endif
+
 // ═════════════════════════════════════════════════════════
 // SETUP
 // ═════════════════════════════════════════════════════════
@@ -26,16 +65,19 @@ void setup() {
       Serial.println();
     }
     
-    Serial.println("════════════════════════════════════");
-    Serial.println("🤖 MOTORVEZÉRLŐ ROBOT INDÍTÁSA");
-    Serial.println("════════════════════════════════════");
+    // Innentől minden üzenet a nem blokkoló log pufferen keresztül megy
+    debugLog.begin();
+    
+    debugLog.println("════════════════════════════════════");
+    debugLog.println("🤖 MOTORVEZÉRLŐ ROBOT INDÍTÁSA");
+    debugLog.println("════════════════════════════════════");
   #endif
   
   // ===== PWM INICIALIZÁLÁSA =====
   if (!motors.init()) {
     #if DEBUG_ENABLED
-      Serial.println("❌ Kritikus hiba: PWM inicializálás sikertelen!");
-      Serial.println("A rendszer leáll.");
+      debugLog.println("❌ Kritikus hiba: PWM inicializálás sikertelen!");
+      debugLog.println("A rendszer leáll.");
     #endif
     while (1) {
       delay(1000);
@@ -47,8 +89,8 @@ void setup() {
   // ===== LoRa INICIALIZÁLÁSA =====
   if (!lora.init()) {
     #if DEBUG_ENABLED
-      Serial.println("❌ Kritikus hiba: LoRa inicializálás sikertelen!");
-      Serial.println("A rendszer leáll.");
+      debugLog.println("❌ Kritikus hiba: LoRa inicializálás sikertelen!");
+      debugLog.println("A rendszer leáll.");
     #endif
     while (1) {
       delay(1000);
@@ -60,81 +102,340 @@ void setup() {
   // ===== ESP-NOW INICIALIZÁLÁSA =====
   if (!espnow.init()) {
     #if DEBUG_ENABLED
-      Serial.println("⚠️ Figyelmeztetés: ESP-NOW inicializálás sikertelen!");
-      Serial.println("A landoló parancsok nem működnek.");
+      debugLog.println("⚠️ Figyelmeztetés: ESP-NOW inicializálás sikertelen!");
+      debugLog.println("A landoló parancsok nem működnek.");
     #endif
   }
   
+  #if TDMA_ENABLED
+    tdma.begin();
+  #endif
+  
   // ===== FAILSAFE INICIALIZÁLÁSA =====
   failsafe.init();
   
+  // ===== PIPELINE TASKOK INDÍTÁSA =====
+  // Előbb a fogyasztó, hogy a rádió task mindig érvényes handle-t értesítsen
+  xTaskCreatePinnedToCore(actuationTask, "Actuation", ACTUATION_TASK_STACK, nullptr,
+                          ACTUATION_TASK_PRIORITY, &actuationTaskHandle, ACTUATION_TASK_CORE);
+  if (!controlTick.begin(actuationTaskHandle)) {
+    #if DEBUG_ENABLED
+      debugLog.println("❌ Kritikus hiba: vezérlési ütem indítása sikertelen!");
+      debugLog.println("A rendszer leáll.");
+    #endif
+    while (1) {
+      delay(1000);
+    }
+  }
+  xTaskCreatePinnedToCore(radioTask, "Radio", RADIO_TASK_STACK, nullptr,
+                          RADIO_TASK_PRIORITY, &radioTaskHandle, RADIO_TASK_CORE);
+  
   #if DEBUG_ENABLED
-    Serial.println("════════════════════════════════════");
-    Serial.println("✅ Motorvezérlő KÉSZEN");
-    Serial.println("✅ LoRa vevő + ESP-NOW adó aktív");
-    Serial.println("✅ LED_FLASH_PIN toggle funkció készen");
-    Serial.println("════════════════════════════════════");
+    debugLog.println("════════════════════════════════════");
+    debugLog.println("✅ Motorvezérlő KÉSZEN");
+    debugLog.println("✅ LoRa vevő + ESP-NOW adó aktív");
+    debugLog.println("✅ LED_FLASH_PIN toggle funkció készen");
+    debugLog.println("✅ Rádió task (core 0) + beavatkozó task (core 1)");
+    debugLog.println("════════════════════════════════════");
   #endif
 }
 
 // ═════════════════════════════════════════════════════════
-// LOOP
+// RÁDIÓ TASK (RADIO_TASK_CORE)
 // ═════════════════════════════════════════════════════════
-void loop() {
-  // ===== LORA HEALTH CHECK =====
-  lora.checkHealth();
+// Health check, csomag fogadás és ellenőrzés, ESP-NOW landoló kezelés.
+// Az érvényes csomagokat a beavatkozó task felé a gyűrűbe teszi,
+// így a LoRa helyreállítás és az ESP-NOW soha nem akasztja meg a PWM-et.
+void radioTask(void* parameter) {
+  // Tele gyűrű miatt el nem küldött sebesség váltások (a következő csomaggal mennek)
+  uint8_t pendingSpeedEvents = 0;
   
-  // ===== CSAK AKKOR OLVAS, HA LORA OK =====
-  if (lora.getState() != LORA_OK) {
-    // Ha LoRa nem OK, motorok leállítása
-    motors.stop();
-    return;
-  }
-  
-  // ===== CSOMAG FOGADÁS =====
-  int receivedPacketSize = lora.parsePacket();
-  if (!receivedPacketSize) {
-    // Nincs csomag - failsafe ellenőrzés
-    if (failsafe.check()) {
-      motors.stop();
+  for (;;) {
+    // ===== LORA HEALTH CHECK =====
+    lora.checkHealth();
+    linkStats.update(millis());
+    #if ADR_ENABLED
+      adr.update(millis());
+    #endif
+    
+    // ===== CSAK AKKOR OLVAS, HA LORA OK =====
+    // Az újraindítás lépésenként halad, a motorokat közben
+    // a beavatkozó task failsafe-je állítja le
+    if (lora.getState() != LORA_OK) {
+      #if TDMA_ENABLED
+        tdma.onLinkReset();
+      #endif
+      vTaskDelay(pdMS_TO_TICKS(lora.isRecovering() ? LORA_RECOVERY_POLL_MS : LORA_RX_WAIT_MS));
+      continue;
     }
-    return;
-  }
-  
-  // ===== CSOMAG ÉRKEZETT =====
-  // Időzítők frissítése
-  lora.updateReceivedTime();
-  failsafe.reset();
-  
-  // ===== CSOMAG MÉRET ELLENŐRZÉS =====
-  if (!packetHandler.validatePacketSize(receivedPacketSize)) {
-    return;
+    
+    // ===== CSOMAG FOGADÁS =====
+    // Megszakításos módban a DIO0 ISR + vételi task tölti a queue-t,
+    // itt legfeljebb LORA_RX_WAIT_MS ideig várunk a következő csomagra
+    TickType_t rxWait = pdMS_TO_TICKS(LORA_RX_WAIT_MS);
+    #if TDMA_ENABLED
+      // TDMA: a saját időrésen kívül a vevő alszik
+      rxWait = tdma.service(esp_timer_get_time());
+      if (!rxWait) {
+        tdma.waitUntilWake(esp_timer_get_time());
+        continue;
+      }
+    #endif
+    
+    LoRaRxPacket rxPacket;
+    if (!lora.receivePacket(rxPacket, rxWait)) {
+      #if !LORA_RX_INTERRUPT_MODE
+        vTaskDelay(1);
+      #endif
+      continue;
+    }
+    
+    // ===== CSOMAG ÉRKEZETT =====
+    lora.updateReceivedTime();
+    linkStats.recordPhy(rxPacket.rssi, rxPacket.snr);
+    
+    // ===== ADR NYUGTA (mérete vagy v2 vezérlő parancsa különbözteti meg) =====
+    #if ADR_ENABLED
+      if (isAdrFrame(rxPacket.data, rxPacket.size)) {
+        adr.onFrame(rxPacket.data, rxPacket.size, millis());
+        continue;
+      }
+    #endif
+    
+    // ===== CSOMAG MÉRET ELLENŐRZÉS =====
+    if (!packetHandler.validatePacketSize(rxPacket.size)) {
+      linkStats.recordSizeError();
+      #if TDMA_ENABLED
+        tdma.onForeignOrCorrupt();
+      #endif
+      continue;
+    }
+    
+    // ===== CSOMAG FELDOLGOZÁSA =====
+    PacketData data = packetHandler.parsePacket(rxPacket.data, rxPacket.size);
+    data.rxTimeUs = rxPacket.irqTimeUs;
+    
+    if (!data.valid) {
+      if (data.status == PACKET_CRC_ERROR) {
+        linkStats.recordCrcFailure();
+      } else if (data.status == PACKET_FOREIGN_ROBOT) {
+        linkStats.recordForeign();
+      } else if (data.status == PACKET_FEC_ERROR) {
+        linkStats.recordFecUncorrectable();
+      }
+      #if TDMA_ENABLED
+        tdma.onForeignOrCorrupt();
+      #endif
+      continue;
+    }
+    
+    #if TDMA_ENABLED
+      tdma.onOwnPacket(rxPacket.irqTimeUs);
+    #endif
+    if (data.fecCorrected) {
+      linkStats.recordFecCorrected();
+    }
+    
+    // ===== SORSZÁM: VESZTÉS / DUPLIKÁTUM / SORRENDCSERE =====
+    bool firstArrival = linkStats.recordSequence(data.sequence, data.copyIndex, millis());
+    if (firstArrival && data.copyIndex > 0) {
+      // Az első példány elveszett, egy ismétlés hozta be
+      linkStats.recordCopyRescue();
+    }
+    
+    // ===== ADR: SNR TARTALÉK MÉRÉS, KÉRÉS / MEGERŐSÍTÉS KÜLDÉSE =====
+    #if ADR_ENABLED
+      adr.onPacket(rxPacket.snr, millis());
+    #endif
+    
+    // ===== ISMÉTLÉSEK SZŰRÉSE: logikai parancsonként egy végrehajtás =====
+    if (!firstArrival) {
+      continue;
+    }
+    
+    // ===== SEBESSÉG VÁLTÁS: SZÁMLÁLÓ EGYEZTETÉSE (elveszett csomag pótlása) =====
+    data.speedEvents = pendingSpeedEvents + speedEvents.reconcile(data.speedEventCount, data.speedEventMask,
+                                                                   data.sequence, millis());
+    
+    // ═════════════════════════════════════════════════════════
+    // LANDOLÓ GOMB KEZELÉSE
+    // ═════════════════════════════════════════════════════════
+    // Az ESP-NOW osztály automatikusan kezeli a funkciót:
+    //   - Ha ESP-NOW aktív: landoló parancs küldése
+    //   - Ha ESP-NOW inaktív: PIN22 toggle
+    espnow.handleLandingState(data.landingState);
+    
+    // ===== ÁTADÁS A BEAVATKOZÓ TASKNAK =====
+    // (a következő vezérlési ütem veszi ki)
+    pendingSpeedEvents = packetRing.push(data) ? 0 : data.speedEvents;
   }
+}
+
+// ═════════════════════════════════════════════════════════
+// BEAVATKOZÓ TASK (ACTUATION_TASK_CORE, CONTROL_TICK_HZ)
+// ═════════════════════════════════════════════════════════
+// Kizárólag ez a task vezérli a motorokat (setup után). Minden ütemben
+// kiüríti a gyűrűt, kiértékeli a failsafe-et és beavatkozik.
+void actuationTask(void* parameter) {
+  // Az utolsó érvényes parancs (failsafe lejtőhöz)
+  DriveInput heldDrive = {};
   
-  // ===== CSOMAG OLVASÁSA =====
-  byte receivedPacket[PACKET_SIZE];
-  for (int i = 0; i < PACKET_SIZE; i++) {
-    receivedPacket[i] = lora.read();
+  for (;;) {
+    controlTick.waitForTick();
+    
+    // A gyűrű teljes kiürítése sorrendben (a sebesség váltásokhoz kell),
+    // a motor parancs ütemenként egyszer, a legfrissebb csomagból
+    bool packetProcessed = false;
+    DriveInput latestDrive = {};
+    #if LATENCY_INSTRUMENTATION
+      uint16_t latestRemoteStamp = 0;
+    #endif
+    PacketData data;
+    while (packetRing.pop(data)) {
+      // ===== SEBESSÉG VÁLTÁS KEZELÉSE =====
+      motors.applySpeedEvents(data.speedEvents);
+      latestDrive = {data.motorCommand, data.throttle, data.steer};
+      packetProcessed = true;
+      
+      #if LATENCY_INSTRUMENTATION
+        // Az ADR futás közben válthat profilt
+        latencyMonitor.setActiveProfile(lora.getPhyProfile());
+        latestRemoteStamp = data.remoteStamp;
+        latencyMonitor.observeArrival(data.remoteStamp, data.rxTimeUs);
+      #endif
+    }
+    
+    if (packetProcessed) {
+      // Az ADR futás közben válthat profilt (légidő a tartási ablakban)
+      failsafe.setActiveProfile(lora.getPhyProfile());
+      failsafe.reset();
+      
+      // ===== MOTOR PARANCS VÉGREHAJTÁSA =====
+      motors.executeDrive(latestDrive);
+      heldDrive = latestDrive;
+      
+      // Gombnyomás (parancs változás) → PWM írás késleltetése
+      #if LATENCY_INSTRUMENTATION
+        static byte previousMotorCommand = 0;
+        if (latestDrive.motorCommand != previousMotorCommand) {
+          latencyMonitor.recordActuation(latestRemoteStamp, esp_timer_get_time());
+          previousMotorCommand = latestDrive.motorCommand;
+        }
+      #endif
+    } else {
+      // Nincs csomag - tartás, lejtő, majd failsafe leállás
+      switch (failsafe.check()) {
+        case FAILSAFE_RAMP:
+          motors.executeDrive(heldDrive, failsafe.getRampScale());
+          break;
+        case FAILSAFE_STOP:
+          motors.hardStop();
+          heldDrive = {};
+          break;
+        case FAILSAFE_HOLD:
+          break;
+      }
+    }
+    
+    // ===== KITÖLTÉS RÁMPA LÉPÉS (motor_slew.h) + KERÉK PID =====
+    motors.updateSlew();
+    
+    controlTick.endTick();
   }
+}
+
+// ═════════════════════════════════════════════════════════
+// LOOP (alacsony prioritású háttérfeladatok)
+// ═════════════════════════════════════════════════════════
+void loop() {
+  // ===== SOROS PARANCSOK (a Serial és a log csak DEBUG_ENABLED mellett indul) =====
+  #if DEBUG_ENABLED
+    while (Serial.available()) {
+      handleSerialCommand((char)Serial.read());
+    }
+  #endif
   
-  // ===== CSOMAG FELDOLGOZÁSA =====
-  PacketData data = packetHandler.parsePacket(receivedPacket);
+  #if DEBUG_ENABLED && DEBUG_PIPELINE
+    static unsigned long lastStatsTime = 0;
+    unsigned long currentTime = millis();
+    if (currentTime - lastStatsTime >= PIPELINE_STATS_INTERVAL_MS) {
+      lastStatsTime = currentTime;
+      debugLog.printf("📊 Pipeline - gyűrű: %lu/%lu | csúcs: %lu | továbbított: %lu | túlcsordulás: %lu",
+                      (unsigned long)packetRing.size(), (unsigned long)packetRing.capacity(),
+                      (unsigned long)packetRing.getHighWatermark(),
+                      (unsigned long)packetRing.getPushedCount(),
+                      (unsigned long)packetRing.getOverflowCount());
+      #if DEBUG_TIMING
+        controlTick.printSummary();
+      #endif
+    }
+  #endif
   
-  if (!data.valid) {
-    return;
+  vTaskDelay(pdMS_TO_TICKS(100));
+}
+
+// ═════════════════════════════════════════════════════════
+// SOROS PARANCSOK
+// ═════════════════════════════════════════════════════════
+//   h - vezérlési ütem hisztogramok kiírása
+//   r - vezérlési ütem hisztogramok nullázása
+//   l - gomb→PWM késleltetés (p50/p99/max) + FIFO kiolvasási idő kiírása
+//   s - link statisztika (utolsó ablak + összesen) kiírása
+//   f - failsafe (csomagköz, tartás, lejtő) statisztika kiírása
+//   w - kerék fordulatszám szabályozás (cél / mért / kitöltés) kiírása (WHEEL_SPEED_CONTROL)
+//   p - PWM frissítés ciklusszám (min/átlag/max) kiírása (MOTOR_PWM_MEASURE)
+//   a - ADR állapot és profilváltás napló kiírása
+//   t - TDMA időrés statisztika (vett / kihagyott / ütközés) kiírása
+// Csak DEBUG_ENABLED mellett: a parancsok a logba írnak.
+#if DEBUG_ENABLED
+void handleSerialCommand(char command) {
+  switch (command) {
+    case 'h':
+      controlTick.dump();
+      break;
+    case 'r':
+      controlTick.requestReset();
+      debugLog.println("🔄 Ütem hisztogramok nullázva");
+      break;
+    case 's':
+      linkStats.dump(millis());
+      // A szinkron szó ellenére átjutott idegen csomagok (azonos szó: ID-k 47-enként)
+      // v2 formátumban az idegen csomag CRC hibaként számolódik
+      debugLog.printf("📶 Szinkron szó: 0x%02X | szoftveres szűrő: %lu idegen csomag",
+                      LORA_SYNC_WORD, (unsigned long)linkStats.getTotal().foreignPackets);
+      speedEvents.dump();
+      break;
+    case 'f':
+      failsafe.dump();
+      break;
+    #if WHEEL_SPEED_CONTROL
+      case 'w':
+        motors.dumpSpeedControl();
+        break;
+    #endif
+    #if MOTOR_PWM_MEASURE
+      case 'p':
+        motors.dumpPwmStats();
+        break;
+    #endif
+    #if ADR_ENABLED
+      case 'a':
+        adr.dump();
+        break;
+    #endif
+    #if TDMA_ENABLED
+      case 't':
+        tdma.dump();
+        break;
+    #endif
+    #if LATENCY_INSTRUMENTATION && DEBUG_LATENCY
+      case 'l':
+        latencyMonitor.dump();
+        lora.dumpFifoReadTime();
+        break;
+    #endif
+    default:
+      break;
   }
-  
-  // ═════════════════════════════════════════════════════════
-  // LANDOLÓ GOMB KEZELÉSE
-  // ═════════════════════════════════════════════════════════
-  // Az ESP-NOW osztály automatikusan kezeli a funkciót:
-  //   - Ha ESP-NOW aktív: landoló parancs küldése
-  //   - Ha ESP-NOW inaktív: PIN22 toggle
-  espnow.handleLandingState(data.landingState);
-  
-  // ===== SEBESSÉG VÁLTÁS KEZELÉSE =====
-  motors.handleSpeedButton(data.speedButtonPressed);
-  
-  // ===== MOTOR PARANCS VÉGREHAJTÁSA =====
-  motors.executeCommand(data.motorCommand);
-}
\ No newline at end of file
+}
+#endif
\ No newline at end of file
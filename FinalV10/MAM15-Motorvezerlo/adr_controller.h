@@ -0,0 +1,325 @@
+#ifndef ADR_CONTROLLER_H
+#define ADR_CONTROLLER_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "settings.h"
+#include "lora_phy_profile.h"
+#include "link_adr.h"
+#include "lora_communication.h"
+#include "packet_handler.h"
+#include "debug_log.h"
+
+static_assert(ADR_FRAME_SIZE != PACKET_V1_AIR_SIZE, "Az ADR keret mérete nem egyezhet a parancs csomagéval");
+static_assert(ADR_MAX_FRAME_SIZE <= PACKET_V1_AIR_SIZE, "Az ADR keret nem fér el a vételi pufferben");
+
+// Az ADR lépcső robusztus vége: a legrobusztusabb profil, amelynek légideje
+// belefér az életjel periódusba és a failsafe ablakba (LoRaCommunication::
+// phyProfileFits). Alapbeállítással (100 ms életjel, 300 ms failsafe) a nagy
+// hatótáv profil (~300 ms légidő) kimarad, a lépcső: legkisebb késés ↔ kiegyensúlyozott.
+constexpr LoRaPhyProfileId adrMostRobustProfile() {
+  int profile = LORA_PROFILE_COUNT - 1;
+  while (profile > 0 && !LoRaCommunication::phyProfileFits((LoRaPhyProfileId)profile)) {
+    profile--;
+  }
+  return (LoRaPhyProfileId)profile;
+}
+
+constexpr LoRaPhyProfileId ADR_MOST_ROBUST_PROFILE = adrMostRobustProfile();
+static_assert(!ADR_ENABLED || ADR_MOST_ROBUST_PROFILE >= LORA_PHY_PROFILE,
+              "Az alap profil (LORA_PHY_PROFILE) kívül esik az ADR lépcsőn");
+
+// ═════════════════════════════════════════════════════════
+// ADAPTÍV ADATSEBESSÉG - ROBOT OLDAL (A RÁDIÓ TASKBÓL HÍVVA)
+// ═════════════════════════════════════════════════════════
+// ADR_WINDOW_MS ablakonként méri az átlagos SNR tartalékot a jelenlegi
+// SF demodulációs küszöbéhez képest:
+//   - ADR_DOWN_MARGIN_DB alatt azonnal robusztusabb profilt kér
+//   - gyorsabb profilt csak akkor kér, ha annak becsült tartaléka
+//     (sávszélesség arányos SNR romlással) ADR_UP_WINDOWS ablakon át
+//     legalább ADR_UP_MARGIN_DB (hiszterézis)
+// Kereteket csak egy vett csomag után küld, amikor a távirányító hallgat.
+class AdrController {
+private:
+  enum AdrState {
+    ADR_STABLE,
+    ADR_REQUESTING,              // Kérés elküldve, ACK-ra vár (régi profilon)
+    ADR_SWITCHING                // Átváltva, az első csomagra vár (új profilon)
+  };
+
+  struct RateChange {
+    unsigned long timeMs;
+    uint8_t fromProfile;
+    uint8_t toProfile;
+    float marginDb;
+    const char* reason;
+  };
+
+  LoRaCommunication& lora;
+  AdrState state;
+  LoRaPhyProfileId previousProfile;
+  LoRaPhyProfileId targetProfile;
+  uint8_t nonce;
+  int requestsSent;
+  unsigned long requestStartTime;
+  unsigned long lastRequestTime;
+  unsigned long switchTime;
+  unsigned long lastBeaconTime;
+  unsigned long lastPacketTime;
+
+  // Mérési ablak
+  unsigned long windowStart;
+  uint32_t windowPackets;
+  float windowSnrSum;
+  float lastMarginDb;
+  int upWindows;
+  int holdoffWindows;
+
+  // Profilváltás napló + számlálók
+  RateChange changes[ADR_LOG_SIZE];
+  uint32_t changeCount;
+  uint32_t requestFailures;
+  uint32_t confirmTimeouts;
+  uint32_t linkLostFallbacks;
+
+  void sendFrame(AdrFrameType type, LoRaPhyProfileId profile) {
+    AdrFrame frame = { ROBOT_ID, type, (uint8_t)profile, nonce };
+    uint8_t buffer[ADR_MAX_FRAME_SIZE];
+    int length = encodeAdrFrameAs<PacketCRC>(PACKET_FORMAT, frame, buffer);
+    lora.transmitFrame(buffer, length);
+  }
+
+  void logChange(unsigned long currentTime, LoRaPhyProfileId from, LoRaPhyProfileId to, const char* reason) {
+    RateChange& change = changes[changeCount % ADR_LOG_SIZE];
+    change.timeMs = currentTime;
+    change.fromProfile = from;
+    change.toProfile = to;
+    change.marginDb = lastMarginDb;
+    change.reason = reason;
+    changeCount++;
+
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.printf("📶 ADR: %s → %s (%s, tartalék: %.1f dB)",
+                      loraPhyProfile(from).name, loraPhyProfile(to).name, reason, lastMarginDb);
+    #endif
+  }
+
+  void startRequest(LoRaPhyProfileId profile, unsigned long currentTime) {
+    nonce = (nonce + 1) & ADR_NONCE_MASK;  // v2 keretben csak 4 bit fér el
+    targetProfile = profile;
+    state = ADR_REQUESTING;
+    requestsSent = 0;
+    requestStartTime = currentTime;
+    lastRequestTime = currentTime - ADR_REQUEST_RETRY_MS;  // Az első a következő csomag után megy
+
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.printf("📶 ADR kérés: %s → %s (tartalék: %.1f dB)",
+                      loraPhyProfile(lora.getPhyProfile()).name, loraPhyProfile(profile).name, lastMarginDb);
+    #endif
+  }
+
+  void abortRequest(const char* reason) {
+    requestFailures++;
+    state = ADR_STABLE;
+    holdoffWindows = ADR_HOLDOFF_WINDOWS;
+
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.printf("⚠️ ADR kérés sikertelen: %s", reason);
+    #endif
+  }
+
+  void resetWindow(unsigned long currentTime) {
+    windowStart = currentTime;
+    windowPackets = 0;
+    windowSnrSum = 0;
+  }
+
+  void evaluateWindow(unsigned long currentTime) {
+    uint32_t packets = windowPackets;
+    float snrSum = windowSnrSum;
+    resetWindow(currentTime);
+
+    if (holdoffWindows > 0) {
+      holdoffWindows--;
+      return;
+    }
+    if (state != ADR_STABLE || packets < ADR_MIN_WINDOW_PACKETS) {
+      upWindows = 0;
+      return;
+    }
+
+    const LoRaPhyProfileId current = lora.getPhyProfile();
+    const LoRaPhyProfile& currentSettings = loraPhyProfile(current);
+    float averageSnr = snrSum / packets;
+    lastMarginDb = averageSnr - loraDemodFloorDb(currentSettings.spreadingFactor);
+
+    // ===== TARTALÉK ÖSSZEOMLOTT: ROBUSZTUSABB PROFIL =====
+    if (lastMarginDb < ADR_DOWN_MARGIN_DB) {
+      upWindows = 0;
+      LoRaPhyProfileId robust = (LoRaPhyProfileId)(current + 1);
+      if (robust <= ADR_MOST_ROBUST_PROFILE) {
+        startRequest(robust, currentTime);
+      }
+      return;
+    }
+
+    // ===== BŐ TARTALÉK: GYORSABB PROFIL (HISZTERÉZISSEL) =====
+    if (current == 0) {
+      upWindows = 0;
+      return;
+    }
+    LoRaPhyProfileId faster = (LoRaPhyProfileId)(current - 1);
+    const LoRaPhyProfile& fasterSettings = loraPhyProfile(faster);
+    // Szélesebb sávban arányosan nagyobb a zaj: a mért SNR ennyivel romlik
+    float bandwidthPenaltyDb = 10.0f * log10f((float)fasterSettings.bandwidthHz / currentSettings.bandwidthHz);
+    float predictedMarginDb = averageSnr - bandwidthPenaltyDb - loraDemodFloorDb(fasterSettings.spreadingFactor);
+
+    if (predictedMarginDb >= ADR_UP_MARGIN_DB && LoRaCommunication::phyProfileFits(faster)) {
+      if (++upWindows >= ADR_UP_WINDOWS) {
+        upWindows = 0;
+        startRequest(faster, currentTime);
+      }
+    } else {
+      upWindows = 0;
+    }
+  }
+
+  bool beaconDue(unsigned long currentTime) const {
+    // Nem alap profilon (vagy nemrég váltva) rendszeres életjel a távirányítónak
+    bool offHome = lora.getPhyProfile() != LORA_PHY_PROFILE;
+    bool recentlySwitched = changeCount && currentTime - switchTime < ADR_CONFIRM_TIMEOUT_MS;
+    return (offHome || recentlySwitched) && currentTime - lastBeaconTime >= ADR_BEACON_INTERVAL_MS;
+  }
+
+public:
+  AdrController(LoRaCommunication& loraCommunication)
+    : lora(loraCommunication)
+    , state(ADR_STABLE)
+    , previousProfile(LORA_PHY_PROFILE)
+    , targetProfile(LORA_PHY_PROFILE)
+    , nonce(0)
+    , requestsSent(0)
+    , requestStartTime(0)
+    , lastRequestTime(0)
+    , switchTime(0)
+    , lastBeaconTime(0)
+    , lastPacketTime(0)
+    , windowStart(0)
+    , windowPackets(0)
+    , windowSnrSum(0)
+    , lastMarginDb(0)
+    , upWindows(0)
+    , holdoffWindows(0)
+    , changeCount(0)
+    , requestFailures(0)
+    , confirmTimeouts(0)
+    , linkLostFallbacks(0) {}
+
+  // Minden érvényes parancs csomag után (a távirányító épp hallgat)
+  void onPacket(float snr, unsigned long currentTime) {
+    lastPacketTime = currentTime;
+    windowPackets++;
+    windowSnrSum += snr;
+
+    switch (state) {
+      case ADR_SWITCHING:
+        // Az új profilon megérkezett az első csomag: megerősítés
+        state = ADR_STABLE;
+        holdoffWindows = ADR_HOLDOFF_WINDOWS;
+        switchTime = currentTime;
+        logChange(currentTime, previousProfile, lora.getPhyProfile(), "megerősítve");
+        sendFrame(ADR_BEACON, lora.getPhyProfile());
+        lastBeaconTime = currentTime;
+        return;
+
+      case ADR_REQUESTING:
+        if (currentTime - lastRequestTime < ADR_REQUEST_RETRY_MS) {
+          return;
+        }
+        if (requestsSent >= ADR_REQUEST_RETRIES) {
+          abortRequest("nincs nyugta");
+          return;
+        }
+        sendFrame(ADR_REQUEST, targetProfile);
+        requestsSent++;
+        lastRequestTime = currentTime;
+        return;
+
+      case ADR_STABLE:
+        if (beaconDue(currentTime)) {
+          sendFrame(ADR_BEACON, lora.getPhyProfile());
+          lastBeaconTime = currentTime;
+        }
+        return;
+    }
+  }
+
+  // Vett ADR keret (nyugta, isAdrFrame szerint)
+  void onFrame(const uint8_t* data, int size, unsigned long currentTime) {
+    AdrFrame frame;
+    if (!decodeAdrFrameAny<PacketCRC>(data, size, ROBOT_ID, frame)) {
+      return;
+    }
+    if (frame.type != ADR_ACK || state != ADR_REQUESTING
+        || frame.nonce != nonce || frame.profile != targetProfile) {
+      return;
+    }
+
+    previousProfile = lora.getPhyProfile();
+    if (!lora.setPhyProfile(targetProfile)) {
+      abortRequest("profil elutasítva");
+      return;
+    }
+    state = ADR_SWITCHING;
+    switchTime = currentTime;
+  }
+
+  // A rádió task minden körében: időtúllépések + ablak kiértékelés
+  void update(unsigned long currentTime) {
+    if (state == ADR_REQUESTING && currentTime - requestStartTime >= ADR_CONFIRM_TIMEOUT_MS) {
+      abortRequest("időtúllépés");
+    }
+
+    // Az új profilon nem jött csomag: vissza (a távirányító is visszaáll)
+    if (state == ADR_SWITCHING && currentTime - switchTime >= ADR_CONFIRM_TIMEOUT_MS) {
+      LoRaPhyProfileId failed = lora.getPhyProfile();
+      lora.setPhyProfile(previousProfile);
+      confirmTimeouts++;
+      state = ADR_STABLE;
+      holdoffWindows = ADR_HOLDOFF_WINDOWS;
+      logChange(currentTime, failed, previousProfile, "megerősítés nélkül vissza");
+    }
+
+    // Tartós kapcsolatvesztés nem alap profilon: mindkét oldal az alapra áll
+    if (state != ADR_SWITCHING && lora.getPhyProfile() != LORA_PHY_PROFILE
+        && currentTime - lastPacketTime >= ADR_LINK_LOST_MS) {
+      LoRaPhyProfileId lost = lora.getPhyProfile();
+      lora.setPhyProfile(LORA_PHY_PROFILE);
+      linkLostFallbacks++;
+      state = ADR_STABLE;
+      holdoffWindows = ADR_HOLDOFF_WINDOWS;
+      logChange(currentTime, lost, LORA_PHY_PROFILE, "kapcsolatvesztés");
+    }
+
+    if (currentTime - windowStart >= ADR_WINDOW_MS) {
+      evaluateWindow(currentTime);
+    }
+  }
+
+  void dump() const {
+    debugLog.printf("📶 ADR - profil: %s | tartalék: %.1f dB | váltások: %lu | sikertelen kérés: %lu | visszaállás: %lu | kapcsolatvesztés: %lu",
+                    loraPhyProfile(lora.getPhyProfile()).name, lastMarginDb,
+                    (unsigned long)changeCount, (unsigned long)requestFailures,
+                    (unsigned long)confirmTimeouts, (unsigned long)linkLostFallbacks);
+    uint32_t first = changeCount > ADR_LOG_SIZE ? changeCount - ADR_LOG_SIZE : 0;
+    for (uint32_t i = first; i < changeCount; i++) {
+      const RateChange& change = changes[i % ADR_LOG_SIZE];
+      debugLog.printf("   %lu ms: %s → %s (%s, %.1f dB)", change.timeMs,
+                      loraPhyProfile((LoRaPhyProfileId)change.fromProfile).name,
+                      loraPhyProfile((LoRaPhyProfileId)change.toProfile).name,
+                      change.reason, change.marginDb);
+    }
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,198 @@
+#ifndef CONTROL_TIMING_H
+#define CONTROL_TIMING_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "settings.h"
+#include "debug_log.h"
+
+// ═════════════════════════════════════════════════════════
+// IDŐZÍTÉSI HISZTOGRAM (log2 vödrök, µs)
+// ═════════════════════════════════════════════════════════
+// 0. vödör: 0 µs, k. vödör: [2^(k-1), 2^k) µs, az utolsó minden nagyobbat gyűjt.
+class TimingHistogram {
+public:
+  static const int BUCKET_COUNT = 21;   // Utolsó vödör: >= ~524 ms
+
+private:
+  uint32_t buckets[BUCKET_COUNT];
+  uint32_t sampleCount;
+  uint32_t maxValue;
+  uint64_t sum;
+
+public:
+  TimingHistogram() {
+    reset();
+  }
+
+  void reset() {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+      buckets[i] = 0;
+    }
+    sampleCount = 0;
+    maxValue = 0;
+    sum = 0;
+  }
+
+  void record(uint32_t valueUs) {
+    int bucket = valueUs ? 32 - __builtin_clz(valueUs) : 0;
+    if (bucket >= BUCKET_COUNT) {
+      bucket = BUCKET_COUNT - 1;
+    }
+    buckets[bucket]++;
+    sampleCount++;
+    sum += valueUs;
+    if (valueUs > maxValue) {
+      maxValue = valueUs;
+    }
+  }
+
+  uint32_t getMax() const {
+    return maxValue;
+  }
+
+  uint32_t getCount() const {
+    return sampleCount;
+  }
+
+  uint32_t getAverage() const {
+    return sampleCount ? (uint32_t)(sum / sampleCount) : 0;
+  }
+
+  // Csak a nem üres vödrök kerülnek kiírásra
+  void dump(const char* name) const {
+    debugLog.printf("📈 %s - minták: %lu | átlag: %lu µs | max: %lu µs",
+                    name, (unsigned long)sampleCount,
+                    (unsigned long)getAverage(), (unsigned long)maxValue);
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+      if (!buckets[i]) {
+        continue;
+      }
+      uint32_t lower = i ? (1UL << (i - 1)) : 0;
+      if (i == BUCKET_COUNT - 1) {
+        debugLog.printf("   >= %lu µs: %lu", (unsigned long)lower, (unsigned long)buckets[i]);
+      } else {
+        uint32_t upper = 1UL << i;
+        debugLog.printf("   %lu-%lu µs: %lu", (unsigned long)lower,
+                        (unsigned long)(upper - 1), (unsigned long)buckets[i]);
+      }
+    }
+  }
+};
+
+// ═════════════════════════════════════════════════════════
+// FIX FREKVENCIÁJÚ VEZÉRLÉSI ÜTEM (esp_timer)
+// ═════════════════════════════════════════════════════════
+// Az esp_timer periodikusan felébreszti a beavatkozó taskot. Mérjük az
+// ütemek közötti eltérést a névleges periódustól (jitter) és az egy
+// ütemben töltött időt (legrosszabb végrehajtási idő).
+class ControlTick {
+private:
+  esp_timer_handle_t timer;
+  TaskHandle_t targetTask;
+  int64_t tickStartUs;
+  int64_t previousTickStartUs;
+  uint32_t overrunCount;
+  volatile bool resetRequested;
+  TimingHistogram jitterHistogram;
+  TimingHistogram executionHistogram;
+
+  static void onTimer(void* argument) {
+    ControlTick* tick = static_cast<ControlTick*>(argument);
+    xTaskNotifyGive(tick->targetTask);
+  }
+
+  void log(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_TIMING
+      debugLog.println(message);
+    #endif
+  }
+
+public:
+  static const uint32_t PERIOD_US = 1000000UL / CONTROL_TICK_HZ;
+
+  ControlTick()
+    : timer(nullptr)
+    , targetTask(nullptr)
+    , tickStartUs(0)
+    , previousTickStartUs(0)
+    , overrunCount(0)
+    , resetRequested(false) {}
+
+  // A megadott taskot ébreszti CONTROL_TICK_HZ frekvenciával
+  bool begin(TaskHandle_t task) {
+    targetTask = task;
+
+    esp_timer_create_args_t timerArgs = {};
+    timerArgs.callback = onTimer;
+    timerArgs.arg = this;
+    timerArgs.dispatch_method = ESP_TIMER_TASK;
+    timerArgs.name = "ControlTick";
+    timerArgs.skip_unhandled_events = true;
+
+    if (esp_timer_create(&timerArgs, &timer) != ESP_OK) {
+      log("❌ Vezérlési ütem időzítő létrehozása sikertelen!");
+      return false;
+    }
+    if (esp_timer_start_periodic(timer, PERIOD_US) != ESP_OK) {
+      log("❌ Vezérlési ütem időzítő indítása sikertelen!");
+      return false;
+    }
+
+    #if DEBUG_ENABLED && DEBUG_TIMING
+      debugLog.printf("✅ Vezérlési ütem: %d Hz (%lu µs)", CONTROL_TICK_HZ, (unsigned long)PERIOD_US);
+    #endif
+    return true;
+  }
+
+  // Blokkol a következő ütemig, majd rögzíti a jittert
+  void waitForTick() {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    tickStartUs = esp_timer_get_time();
+
+    if (resetRequested) {
+      jitterHistogram.reset();
+      executionHistogram.reset();
+      overrunCount = 0;
+      previousTickStartUs = 0;
+      resetRequested = false;
+    }
+
+    if (previousTickStartUs) {
+      int64_t period = tickStartUs - previousTickStartUs;
+      int64_t deviation = period - (int64_t)PERIOD_US;
+      jitterHistogram.record((uint32_t)(deviation < 0 ? -deviation : deviation));
+    }
+    previousTickStartUs = tickStartUs;
+  }
+
+  // Az ütem végén hívandó: végrehajtási idő rögzítése
+  void endTick() {
+    uint32_t executionUs = (uint32_t)(esp_timer_get_time() - tickStartUs);
+    executionHistogram.record(executionUs);
+    if (executionUs > PERIOD_US) {
+      overrunCount++;
+    }
+  }
+
+  void requestReset() {
+    resetRequested = true;
+  }
+
+  void dump() const {
+    debugLog.printf("⏱️ Vezérlési ütem: %d Hz | túlfutás: %lu", CONTROL_TICK_HZ, (unsigned long)overrunCount);
+    jitterHistogram.dump("Ütem jitter");
+    executionHistogram.dump("Ütem végrehajtási idő");
+  }
+
+  void printSummary() const {
+    debugLog.printf("⏱️ Ütem - jitter max: %lu µs | végrehajtás max: %lu µs | túlfutás: %lu",
+                    (unsigned long)jitterHistogram.getMax(),
+                    (unsigned long)executionHistogram.getMax(),
+                    (unsigned long)overrunCount);
+  }
+};
+
+#endif
\ No newline at end of file
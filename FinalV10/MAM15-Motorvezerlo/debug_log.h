@@ -0,0 +1,155 @@
+#ifndef DEBUG_LOG_H
+#define DEBUG_LOG_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "settings.h"
+
+// ═════════════════════════════════════════════════════════
+// NEM BLOKKOLÓ DEBUG NAPLÓZÁS
+// ═════════════════════════════════════════════════════════
+// A hívó csak egy RAM-beli sorba formáz (néhány µs), a soros portra
+// egy alacsony prioritású task írja ki. Tele gyűrű esetén az új sor
+// eldobásra kerül és a számláló nő - a hívó soha nem vár az UART-ra.
+class DebugLog {
+private:
+  struct Line {
+    volatile bool ready;
+    uint8_t length;
+    char text[LOG_LINE_LENGTH];
+  };
+
+  Line lines[LOG_RING_LINES];
+  uint32_t head;                     // Következő lefoglalandó sor
+  uint32_t tail;                     // Következő kiírandó sor
+  uint32_t writtenCount;
+  uint32_t droppedCount;
+  uint32_t reportedDroppedCount;
+  portMUX_TYPE lock;
+  TaskHandle_t drainTaskHandle;
+
+  // Sor lefoglalása (rövid kritikus szakasz, a formázás már azon kívül fut)
+  Line* reserve() {
+    Line* line = nullptr;
+    portENTER_CRITICAL_SAFE(&lock);
+    if (head - tail < LOG_RING_LINES) {
+      line = &lines[head % LOG_RING_LINES];
+      head++;
+    } else {
+      droppedCount++;
+    }
+    portEXIT_CRITICAL_SAFE(&lock);
+    return line;
+  }
+
+  void commit(Line* line, int length) {
+    if (length < 0) {
+      length = 0;
+    }
+    if (length >= LOG_LINE_LENGTH) {
+      length = LOG_LINE_LENGTH - 1;
+    }
+    line->length = (uint8_t)length;
+    __atomic_store_n(&line->ready, true, __ATOMIC_RELEASE);
+  }
+
+  static void drainTaskEntry(void* parameter) {
+    static_cast<DebugLog*>(parameter)->drainTaskLoop();
+  }
+
+  void drainTaskLoop() {
+    for (;;) {
+      drain();
+      vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+    }
+  }
+
+  void drain() {
+    for (;;) {
+      portENTER_CRITICAL_SAFE(&lock);
+      bool empty = (tail == head);
+      Line* line = &lines[tail % LOG_RING_LINES];
+      portEXIT_CRITICAL_SAFE(&lock);
+
+      // Üres, vagy a következő sor formázása még folyamatban
+      if (empty || !__atomic_load_n(&line->ready, __ATOMIC_ACQUIRE)) {
+        break;
+      }
+
+      Serial.write((const uint8_t*)line->text, line->length);
+      Serial.write((const uint8_t*)"\r\n", 2);
+      line->ready = false;
+
+      portENTER_CRITICAL_SAFE(&lock);
+      tail++;
+      writtenCount++;
+      portEXIT_CRITICAL_SAFE(&lock);
+    }
+
+    if (droppedCount != reportedDroppedCount) {
+      uint32_t newlyDropped = droppedCount - reportedDroppedCount;
+      reportedDroppedCount += newlyDropped;
+      Serial.printf("⚠️ Log puffer tele - %lu sor eldobva (összesen: %lu)\r\n",
+                    (unsigned long)newlyDropped, (unsigned long)reportedDroppedCount);
+    }
+  }
+
+public:
+  DebugLog()
+    : head(0)
+    , tail(0)
+    , writtenCount(0)
+    , droppedCount(0)
+    , reportedDroppedCount(0)
+    , drainTaskHandle(nullptr) {
+    portMUX_INITIALIZE(&lock);
+    for (int i = 0; i < LOG_RING_LINES; i++) {
+      lines[i].ready = false;
+      lines[i].length = 0;
+    }
+  }
+
+  bool begin() {
+    return xTaskCreatePinnedToCore(drainTaskEntry, "LogDrain", LOG_DRAIN_TASK_STACK, this,
+                                   LOG_DRAIN_TASK_PRIORITY, &drainTaskHandle,
+                                   tskNO_AFFINITY) == pdPASS;
+  }
+
+  void println(const char* message) {
+    Line* line = reserve();
+    if (!line) {
+      return;
+    }
+    size_t length = strnlen(message, LOG_LINE_LENGTH - 1);
+    memcpy(line->text, message, length);
+    line->text[length] = '\0';
+    commit(line, (int)length);
+  }
+
+  __attribute__((format(printf, 2, 3)))
+  void printf(const char* format, ...) {
+    Line* line = reserve();
+    if (!line) {
+      return;
+    }
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line->text, LOG_LINE_LENGTH, format, args);
+    va_end(args);
+    commit(line, length);
+  }
+
+  uint32_t getWrittenCount() const {
+    return writtenCount;
+  }
+
+  uint32_t getDroppedCount() const {
+    return droppedCount;
+  }
+};
+
+// Globális napló példány (minden modul ezen keresztül ír)
+DebugLog debugLog;
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef DRIVE_MIXER_H
+#define DRIVE_MIXER_H
+
+#include <stdint.h>
+
+// ═════════════════════════════════════════════════════════
+// ARÁNYOS VEZÉRLÉS: DIFFERENCIÁL KEVERŐ
+// ═════════════════════════════════════════════════════════
+// Előjeles gáz és kormány (-127..127) → bal / jobb előjeles kitöltés.
+// Tengelyenként:
+//   1. holtsáv: a középállás körüli zaj nulla, a maradék tartomány
+//      újraskálázva (a holtsáv szélén nincs ugrás)
+//   2. expo: lineáris és köbös görbe keveréke - középen finomabb,
+//      végálláson ugyanúgy teljes kitérés
+// Keverés: bal = gáz + kormány, jobb = gáz - kormány. Ha valamelyik
+// túllépi a skálát, mindkettő arányosan csökken (telítés kezelés), így
+// a kanyarodás íve nem torzul. Végül a ±maxDuty tartományra vetít.
+//
+// Tiszta függvények (nincs állapot, nincs hardver) - gazdagépen is tesztelhető.
+#define DRIVE_AXIS_MAX 127
+
+struct DriveInput {
+  uint8_t motorCommand;        // Gomb bitmaszk (tartalék mód)
+  int8_t throttle;             // + előre
+  int8_t steer;                // + jobbra
+};
+
+struct WheelDuty {
+  int left;                    // Előjeles kitöltés (+ előre, - hátra)
+  int right;
+};
+
+struct MixerConfig {
+  int deadband;                // Holtsáv (0..DRIVE_AXIS_MAX-1)
+  int expoPercent;             // 0 = lineáris, 100 = tisztán köbös
+};
+
+// Holtsáv + expo egy tengelyen (-127..127 → -127..127)
+constexpr int shapeDriveAxis(int value, const MixerConfig& config) {
+  int magnitude = value < 0 ? -value : value;
+  if (magnitude > DRIVE_AXIS_MAX) {
+    magnitude = DRIVE_AXIS_MAX;
+  }
+  if (magnitude <= config.deadband) {
+    return 0;
+  }
+  int32_t scaled = (int32_t)(magnitude - config.deadband) * DRIVE_AXIS_MAX / (DRIVE_AXIS_MAX - config.deadband);
+  int32_t cubic = scaled * scaled * scaled / (DRIVE_AXIS_MAX * DRIVE_AXIS_MAX);
+  int32_t shaped = ((100 - config.expoPercent) * scaled + config.expoPercent * cubic) / 100;
+  return value < 0 ? -(int)shaped : (int)shaped;
+}
+
+// A kar kitérése a holtsávon kívül van-e (különben gomb bitmaszk mód)
+constexpr bool isDriveDeflected(int8_t throttle, int8_t steer, const MixerConfig& config) {
+  return (throttle > config.deadband || throttle < -config.deadband ||
+          steer > config.deadband || steer < -config.deadband);
+}
+
+constexpr WheelDuty mixDrive(int8_t throttle, int8_t steer, int maxDuty, const MixerConfig& config) {
+  int shapedThrottle = shapeDriveAxis(throttle, config);
+  int shapedSteer = shapeDriveAxis(steer, config);
+  int32_t left = shapedThrottle + shapedSteer;
+  int32_t right = shapedThrottle - shapedSteer;
+
+  // Telítés: a nagyobbik kerék a skála szélére, a másik arányosan
+  int32_t peak = left < 0 ? -left : left;
+  int32_t rightMagnitude = right < 0 ? -right : right;
+  if (rightMagnitude > peak) {
+    peak = rightMagnitude;
+  }
+  if (peak < DRIVE_AXIS_MAX) {
+    peak = DRIVE_AXIS_MAX;
+  }
+  return WheelDuty{(int)(left * maxDuty / peak), (int)(right * maxDuty / peak)};
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef EVENT_CHANNEL_H
+#define EVENT_CHANNEL_H
+
+#include <stdint.h>
+#include "settings.h"
+#include "debug_log.h"
+
+// ═════════════════════════════════════════════════════════
+// DISZKRÉT ESEMÉNYEK EGYEZTETÉSE (SEBESSÉG VÁLTÁS)
+// ═════════════════════════════════════════════════════════
+// A távirányító minden gombnyomásnál növel egy körbeforduló számlálót, és
+// azt minden csomagban (életjelben is) elküldi. A robot a legutóbb
+// alkalmazott értékhez képesti különbséget hajtja végre, így egy elveszett
+// csomag eseményét a következő megérkező csomag pótolja - pontosan egyszer.
+// A motor bitek ettől függetlenül "legfrissebb nyer" alapon mennek.
+//
+// Számláló szélesség (mask): v1 8 bit, v2 3 bit - egy kiesésbe eső legfeljebb
+// mask gombnyomás pontosan egyszer hajtódik végre. SPEED_EVENT_RESYNC_MS-nél
+// hosszabb csend után a számláló új alapértéket vesz fel (újraindult távirányító).
+// Csak a rádió task használja (a sorszám sorrend ott ismert).
+class EventReconciler {
+private:
+  // Ennél régebbi sorszám késve érkezett csomag (nem lép vissza a számláló)
+  static constexpr int8_t REORDER_WINDOW = 32;
+
+  bool synced;
+  uint8_t lastCount;
+  uint8_t lastSequence;
+  unsigned long lastPacketTime;
+  uint32_t appliedEvents;
+  uint32_t recoveredEvents;      // Sorszám kiesés után érkezett (egyszeri jelzéssel elveszett volna)
+  uint32_t resyncCount;          // Új alapérték: hosszú csend vagy visszalépő számláló
+
+public:
+  EventReconciler()
+    : synced(false),
+      lastCount(0),
+      lastSequence(0),
+      lastPacketTime(0),
+      appliedEvents(0),
+      recoveredEvents(0),
+      resyncCount(0) {}
+
+  // Visszatérés: a csomaggal érkezett új események száma
+  uint8_t reconcile(uint8_t count, uint8_t mask, uint8_t sequence, unsigned long currentTime) {
+    count &= mask;
+    int8_t sequenceStep = (int8_t)(sequence - lastSequence);
+    bool silent = currentTime - lastPacketTime > SPEED_EVENT_RESYNC_MS;
+    lastPacketTime = currentTime;
+
+    // Első csomag / hosszú csend: csak felvesszük az alapértéket
+    if (!synced || silent) {
+      if (synced) {
+        resyncCount++;
+      }
+      synced = true;
+      lastCount = count;
+      lastSequence = sequence;
+      return 0;
+    }
+
+    // Duplikátum vagy késve érkezett (régebbi) csomag
+    if (sequenceStep <= 0 && sequenceStep > -REORDER_WINDOW) {
+      return 0;
+    }
+
+    uint8_t events = (uint8_t)(count - lastCount) & mask;
+    lastCount = count;
+    lastSequence = sequence;
+
+    // Visszalépő 8 bites számláló: újraindult távirányító, új alapérték
+    // (a 3 bites v2 számlálónál a teljes tartomány érvényes kiesés)
+    if (mask == 0xFF && events > mask / 2) {
+      resyncCount++;
+      return 0;
+    }
+
+    appliedEvents += events;
+    if (sequenceStep > 1) {
+      recoveredEvents += events;
+    }
+    return events;
+  }
+
+  uint32_t getRecoveredEvents() const {
+    return recoveredEvents;
+  }
+
+  void dump() const {
+    debugLog.printf("⚡ Események - alkalmazva: %lu | pótolva: %lu | újraszinkron: %lu",
+                    (unsigned long)appliedEvents, (unsigned long)recoveredEvents,
+                    (unsigned long)resyncCount);
+  }
+};
+
+#endif
\ No newline at end of file
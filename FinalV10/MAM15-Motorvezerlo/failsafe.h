@@ -1,56 +1,210 @@
-#ifndef FAILSAFE_H
-#define FAILSAFE_H
-
-#include <Arduino.h>
-#include "settings.h"
-
-class Failsafe {
-private:
-  unsigned long lastSafeTime;
-  bool failsafeActive;
-
-  void log(const char* message) {
-    #if DEBUG_ENABLED && DEBUG_FAILSAFE
-      Serial.println(message);
-    #endif
-  }
-
-public:
-  Failsafe() : lastSafeTime(0), failsafeActive(false) {}
-
-  void reset() {
-    lastSafeTime = millis();
-    if (failsafeActive) {
-      failsafeActive = false;
-      log("✅ Failsafe deaktiválva - normál működés");
-    }
-  }
-
-  bool check() {
-    unsigned long currentTime = millis();
-    
-    if (currentTime - lastSafeTime > FAILSAFE_TIMEOUT_MS) {
-      if (!failsafeActive) {
-        log("⚠️ FAILSAFE AKTIVÁLVA - Nincs kommunikáció!");
-        failsafeActive = true;
-      }
-      
-      // Időzítő reset (de failsafe aktív marad)
-      lastSafeTime = currentTime - FAILSAFE_TIMEOUT_MS + 1000;
-      return true;
-    }
-    
-    return false;
-  }
-
-  bool isActive() const {
-    return failsafeActive;
-  }
-
-  void init() {
-    lastSafeTime = millis();
-    failsafeActive = false;
-  }
-};
-
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include <Arduino.h>
+#include "settings.h"
+#include "lora_phy_profile.h"
+#include "packet_v2.h"
+#include "packet_fec.h"
+#include "debug_log.h"
+
+static_assert(FAILSAFE_HOLD_MIN_MS + FAILSAFE_RAMP_MS <= FAILSAFE_TIMEOUT_MS,
+              "A tartás + lejtő nem fér bele a FAILSAFE_TIMEOUT_MS ablakba");
+
+// A leghosszabb normál csomagköz az adott profilon: változás sorozat után a
+// következő csomag csak REMOTE_KEEPALIVE_INTERVAL_MS múlva jövő életjel (+ egy
+// elveszett utolsó ismétlés szünete, a légidő és egy vezérlési ütem)
+constexpr uint32_t failsafeKeepaliveGapMs(LoRaPhyProfileId profile) {
+  return REMOTE_KEEPALIVE_INTERVAL_MS + REMOTE_REPEAT_MAX_GAP_MS
+         + (loraTimeOnAirUs(loraPhyProfile(profile), LORA_FRAME_SIZE, LORA_IMPLICIT_HEADER) + 999) / 1000
+         + 1000 / CONTROL_TICK_HZ;
+}
+
+static_assert(failsafeKeepaliveGapMs(LORA_PHY_PROFILE) + FAILSAFE_RAMP_MS <= FAILSAFE_TIMEOUT_MS,
+              "Az életjelek közti csomagköz + lejtő nem fér bele a FAILSAFE_TIMEOUT_MS ablakba");
+
+// Teljes kitöltés skála (motor_control.h executeCommand outputScale)
+#define FAILSAFE_FULL_SCALE 256
+
+// A beavatkozó task teendője csomag nélküli ütemben
+enum FailsafeAction {
+  FAILSAFE_HOLD,               // Az utolsó parancs marad (vagy már leállt)
+  FAILSAFE_RAMP,               // Az utolsó parancs csökkenő kitöltéssel (getRampScale)
+  FAILSAFE_STOP                // Leállítás
+};
+
+// ═════════════════════════════════════════════════════════
+// KÉTLÉPCSŐS FAILSAFE
+// ═════════════════════════════════════════════════════════
+// 1. Tartás: a mért csomagköz FAILSAFE_HOLD_INTERVALS-szorosáig az utolsó
+//    érvényes parancs marad - egy-két elveszett csomag nem rántja meg a robotot.
+//    A tartás sosem rövidebb az életjelek közti csomagköznél: gyors változás
+//    sorozat (pl. kar mozgatás) után a mért átlag lecsökken, de a kar
+//    elengedése után a következő csomag csak az életjel.
+// 2. Lejtő: FAILSAFE_RAMP_MS alatt lineárisan nullára csökken a kitöltés.
+// A tartás felső korlátja miatt a leállás legkésőbb FAILSAFE_TIMEOUT_MS-nél
+// bekövetkezik, ha a kapcsolat valóban megszakadt.
+class Failsafe {
+private:
+  unsigned long lastSafeTime;
+  unsigned long lastStopTime;
+  uint32_t intervalEstimateMs;   // Csomagköz becslés (lassan csökken, gyorsan nő)
+  uint32_t holdFloorMs;          // Tartás alsó korlátja az aktív profilon
+  bool failsafeActive;
+  bool rampActive;
+
+  uint32_t bridgedGapCount;      // Tartással áthidalt kiesés (csomag a lejtő előtt)
+  uint32_t rampRecoveryCount;    // Lejtő közben visszatért kapcsolat
+  uint32_t stopCount;
+
+  void log(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_FAILSAFE
+      debugLog.println(message);
+    #endif
+  }
+
+  // A kiugró (kiesés okozta) csomagköz legfeljebb a tartás felső korlátjáig számít
+  void updateIntervalEstimate(uint32_t intervalMs) {
+    if (intervalMs > getHoldMaxMs()) {
+      intervalMs = getHoldMaxMs();
+    }
+    if (intervalMs > intervalEstimateMs) {
+      intervalEstimateMs += (intervalMs - intervalEstimateMs + 3) / 4;
+    } else {
+      intervalEstimateMs -= (intervalEstimateMs - intervalMs) / 16;
+    }
+  }
+
+  static constexpr uint32_t getHoldMaxMs() {
+    return FAILSAFE_TIMEOUT_MS - FAILSAFE_RAMP_MS;
+  }
+
+  static uint32_t holdFloorFor(LoRaPhyProfileId profile) {
+    uint32_t floorMs = failsafeKeepaliveGapMs(profile);
+    if (floorMs < FAILSAFE_HOLD_MIN_MS) {
+      floorMs = FAILSAFE_HOLD_MIN_MS;
+    }
+    return floorMs > getHoldMaxMs() ? getHoldMaxMs() : floorMs;
+  }
+
+public:
+  Failsafe()
+    : lastSafeTime(0),
+      lastStopTime(0),
+      intervalEstimateMs(REMOTE_KEEPALIVE_INTERVAL_MS),
+      holdFloorMs(holdFloorFor(LORA_PHY_PROFILE)),
+      failsafeActive(false),
+      rampActive(false),
+      bridgedGapCount(0),
+      rampRecoveryCount(0),
+      stopCount(0) {}
+
+  void reset() {
+    unsigned long currentTime = millis();
+    uint32_t intervalMs = currentTime - lastSafeTime;
+    lastSafeTime = currentTime;
+
+    if (failsafeActive) {
+      failsafeActive = false;
+      log("✅ Failsafe deaktiválva - normál működés");
+      return;
+    }
+    if (rampActive) {
+      rampActive = false;
+      rampRecoveryCount++;
+    } else if (intervalMs > holdFloorMs) {
+      bridgedGapCount++;
+    }
+    updateIntervalEstimate(intervalMs);
+  }
+
+  // Az ADR futás közben válthat profilt (a légidő a tartás alsó korlátjában van)
+  void setActiveProfile(LoRaPhyProfileId profile) {
+    if (profile >= 0 && profile < LORA_PROFILE_COUNT) {
+      holdFloorMs = holdFloorFor(profile);
+    }
+  }
+
+  // Tartási ablak: a mért csomagköz többszöröse, korlátok között
+  uint32_t getHoldWindowMs() const {
+    uint32_t holdMs = intervalEstimateMs * FAILSAFE_HOLD_INTERVALS;
+    if (holdMs < holdFloorMs) {
+      return holdFloorMs;
+    }
+    return holdMs > getHoldMaxMs() ? getHoldMaxMs() : holdMs;
+  }
+
+  FailsafeAction check() {
+    unsigned long currentTime = millis();
+    uint32_t elapsedMs = currentTime - lastSafeTime;
+
+    if (failsafeActive) {
+      // Ismételt leállítás másodpercenként (mint korábban)
+      if (currentTime - lastStopTime >= 1000) {
+        lastStopTime = currentTime;
+        return FAILSAFE_STOP;
+      }
+      return FAILSAFE_HOLD;
+    }
+
+    uint32_t holdMs = getHoldWindowMs();
+    if (elapsedMs <= holdMs) {
+      return FAILSAFE_HOLD;
+    }
+
+    if (elapsedMs < holdMs + FAILSAFE_RAMP_MS) {
+      if (!rampActive) {
+        rampActive = true;
+        #if DEBUG_ENABLED && DEBUG_FAILSAFE
+          debugLog.printf("⚠️ Failsafe lejtő - nincs csomag %lu ms óta", (unsigned long)elapsedMs);
+        #endif
+      }
+      return FAILSAFE_RAMP;
+    }
+
+    log("⚠️ FAILSAFE AKTIVÁLVA - Nincs kommunikáció!");
+    failsafeActive = true;
+    rampActive = false;
+    lastStopTime = currentTime;
+    stopCount++;
+    return FAILSAFE_STOP;
+  }
+
+  // A lejtő aktuális kitöltés szorzója (0..FAILSAFE_FULL_SCALE)
+  uint16_t getRampScale() const {
+    uint32_t rampElapsedMs = millis() - lastSafeTime - getHoldWindowMs();
+    if (rampElapsedMs >= FAILSAFE_RAMP_MS) {
+      return 0;
+    }
+    return (uint16_t)(FAILSAFE_FULL_SCALE * (FAILSAFE_RAMP_MS - rampElapsedMs) / FAILSAFE_RAMP_MS);
+  }
+
+  bool isActive() const {
+    return failsafeActive;
+  }
+
+  bool isRamping() const {
+    return rampActive;
+  }
+
+  uint32_t getBridgedGapCount() const {
+    return bridgedGapCount;
+  }
+
+  void dump() const {
+    debugLog.printf("🛡️ Failsafe - csomagköz: %lu ms | tartás: %lu ms (min. %lu) | lejtő: %d ms",
+                    (unsigned long)intervalEstimateMs, (unsigned long)getHoldWindowMs(),
+                    (unsigned long)holdFloorMs, FAILSAFE_RAMP_MS);
+    debugLog.printf("🛡️ Áthidalt kiesés: %lu | lejtőből visszatért: %lu | leállás: %lu",
+                    (unsigned long)bridgedGapCount, (unsigned long)rampRecoveryCount,
+                    (unsigned long)stopCount);
+  }
+
+  void init() {
+    lastSafeTime = millis();
+    failsafeActive = false;
+    rampActive = false;
+  }
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef LATENCY_MONITOR_H
+#define LATENCY_MONITOR_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "settings.h"
+#include "lora_phy_profile.h"
+#include "packet_v2.h"
+#include "packet_fec.h"
+#include "debug_log.h"
+
+// ═════════════════════════════════════════════════════════
+// GOMBNYOMÁS → PWM KÉSLELTETÉS MÉRÉS (LATENCY_INSTRUMENTATION)
+// ═════════════════════════════════════════════════════════
+// A távirányító a gombok mintavételének idejét 16 bites,
+// LATENCY_STAMP_UNIT_US felbontású időbélyegként küldi. A két óra
+// közötti eltolást a (vételi idő - időbélyeg) minimumából becsüljük
+// ablakonként (így a kristályok elcsúszását is követi). A minimum a
+// leggyorsabb út idejét is elnyeli: ezt az aktív profil légideje pótolja
+// (a keret a mintavétel után legkorábban a légidő végén érkezhet meg).
+class LatencyMonitor {
+public:
+  static const int BUCKET_COUNT = LATENCY_HIST_BUCKETS + 1;  // + túlcsordulás
+
+private:
+  struct Histogram {
+    uint32_t buckets[BUCKET_COUNT];
+    uint32_t sampleCount;
+    uint32_t maxUs;
+  };
+
+  Histogram histograms[LATENCY_PROFILE_SLOTS];
+  int activeProfile;
+  uint32_t linkFloorUs;        // Az aktív profil légideje (leggyorsabb út)
+
+  // Óra eltolás becslés (időbélyeg egységben, 16 bites körbeforduló)
+  bool offsetValid;
+  uint16_t offsetTicks;
+  uint16_t windowMinTicks;
+  int windowSamples;
+
+  static uint16_t nowTicks(int64_t timeUs) {
+    return (uint16_t)(timeUs / LATENCY_STAMP_UNIT_US);
+  }
+
+  static uint32_t percentileUs(const Histogram& histogram, uint32_t permille) {
+    if (!histogram.sampleCount) {
+      return 0;
+    }
+    uint32_t target = (histogram.sampleCount * permille + 999) / 1000;
+    uint32_t cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+      cumulative += histogram.buckets[i];
+      if (cumulative >= target) {
+        // A vödör felső határa (túlcsordulásnál a maximum)
+        return i == BUCKET_COUNT - 1 ? histogram.maxUs : (uint32_t)(i + 1) * LATENCY_HIST_BUCKET_US;
+      }
+    }
+    return histogram.maxUs;
+  }
+
+  static uint32_t airtimeUs(int profile) {
+    return loraTimeOnAirUs(loraPhyProfile((LoRaPhyProfileId)profile), LORA_FRAME_SIZE, LORA_IMPLICIT_HEADER);
+  }
+
+public:
+  LatencyMonitor()
+    : activeProfile(0)
+    , linkFloorUs(airtimeUs(0))
+    , offsetValid(false)
+    , offsetTicks(0)
+    , windowMinTicks(0)
+    , windowSamples(0) {
+    reset();
+  }
+
+  void reset() {
+    for (int p = 0; p < LATENCY_PROFILE_SLOTS; p++) {
+      for (int i = 0; i < BUCKET_COUNT; i++) {
+        histograms[p].buckets[i] = 0;
+      }
+      histograms[p].sampleCount = 0;
+      histograms[p].maxUs = 0;
+    }
+  }
+
+  // A hisztogramok PHY profilonként külön gyűlnek
+  void setActiveProfile(int profile) {
+    if (profile >= 0 && profile < LATENCY_PROFILE_SLOTS) {
+      activeProfile = profile;
+      linkFloorUs = airtimeUs(profile);
+    }
+  }
+
+  // Minden érvényes csomagnál: óra eltolás becslés frissítése
+  void observeArrival(uint16_t remoteStamp, int64_t rxTimeUs) {
+    uint16_t delta = (uint16_t)(nowTicks(rxTimeUs) - remoteStamp);
+
+    if (!offsetValid) {
+      offsetTicks = delta;
+      windowMinTicks = delta;
+      offsetValid = true;
+      return;
+    }
+
+    // Új minimum azonnal érvényes
+    if ((int16_t)(delta - offsetTicks) < 0) {
+      offsetTicks = delta;
+    }
+    if ((int16_t)(delta - windowMinTicks) < 0) {
+      windowMinTicks = delta;
+    }
+
+    // Ablak végén az eltolás az ablak minimumára áll (drift követés)
+    if (++windowSamples >= LATENCY_OFFSET_WINDOW) {
+      offsetTicks = windowMinTicks;
+      windowMinTicks = delta;
+      windowSamples = 0;
+    }
+  }
+
+  // A PWM kimenetek írása után: késleltetés rögzítése
+  void recordActuation(uint16_t remoteStamp, int64_t actuationTimeUs) {
+    if (!offsetValid) {
+      return;
+    }
+
+    int16_t ticks = (int16_t)(nowTicks(actuationTimeUs) - remoteStamp - offsetTicks);
+    if (ticks < 0) {
+      ticks = 0;
+    }
+    uint32_t latencyUs = (uint32_t)ticks * LATENCY_STAMP_UNIT_US + linkFloorUs;
+
+    Histogram& histogram = histograms[activeProfile];
+    int bucket = latencyUs / LATENCY_HIST_BUCKET_US;
+    if (bucket >= BUCKET_COUNT) {
+      bucket = BUCKET_COUNT - 1;
+    }
+    histogram.buckets[bucket]++;
+    histogram.sampleCount++;
+    if (latencyUs > histogram.maxUs) {
+      histogram.maxUs = latencyUs;
+    }
+  }
+
+  void dump() const {
+    debugLog.printf("⏲️ Gomb→PWM késleltetés (padló: %lu µs légidő, felbontás: %d µs)",
+                    (unsigned long)linkFloorUs, LATENCY_HIST_BUCKET_US);
+    for (int p = 0; p < LATENCY_PROFILE_SLOTS; p++) {
+      const Histogram& histogram = histograms[p];
+      debugLog.printf("   %s%s: n=%lu | p50: %lu µs | p99: %lu µs | max: %lu µs",
+                      p == activeProfile ? "▶ " : "  ", LORA_PHY_PROFILES[p].name,
+                      (unsigned long)histogram.sampleCount,
+                      (unsigned long)percentileUs(histogram, 500),
+                      (unsigned long)percentileUs(histogram, 990),
+                      (unsigned long)histogram.maxUs);
+    }
+  }
+};
+
+#endif
\ No newline at end of file
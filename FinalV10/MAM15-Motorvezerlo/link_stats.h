@@ -0,0 +1,263 @@
+#ifndef LINK_STATS_H
+#define LINK_STATS_H
+
+#include <Arduino.h>
+#include "settings.h"
+#include "debug_log.h"
+
+// ═════════════════════════════════════════════════════════
+// LINK MINŐSÉG STATISZTIKA (LINK_STATS_WINDOW_MS ablakonként)
+// ═════════════════════════════════════════════════════════
+// A sorszámokból vesztést, duplikátumot és sorrendcserét számol.
+// Az utolsó LINK_SEQ_HISTORY sorszámot bitmaszk tartja nyilván, így egy
+// késve érkező csomag (sorrendcsere) megkülönböztethető a duplikátumtól.
+struct LinkWindowStats {
+  uint32_t received;           // Érvényes, új csomagok
+  uint32_t lost;               // Sorszám hézagok
+  uint32_t duplicates;         // Köztük a távirányító ismétlései
+  uint32_t rescuedByCopy;      // Az első példány elveszett, egy ismétlés hozta (v1)
+  uint32_t reordered;
+  uint32_t crcFailures;
+  uint32_t foreignPackets;     // Másik robotnak szóló csomagok
+  uint32_t sizeErrors;
+  uint32_t fecCorrected;       // Hibajavítással megmentett csomagok (PACKET_FEC)
+  uint32_t fecUncorrectable;   // Javíthatatlan (2+ bithiba egy kódszóban)
+  uint32_t rssiSamples;
+  int32_t rssiSum;
+  int16_t rssiMin;
+  int16_t rssiMax;
+  float snrSum;
+  float snrMin;
+  float snrMax;
+  unsigned long durationMs;
+
+  void clear() {
+    received = 0;
+    lost = 0;
+    duplicates = 0;
+    rescuedByCopy = 0;
+    reordered = 0;
+    crcFailures = 0;
+    foreignPackets = 0;
+    sizeErrors = 0;
+    fecCorrected = 0;
+    fecUncorrectable = 0;
+    rssiSamples = 0;
+    rssiSum = 0;
+    rssiMin = 0;
+    rssiMax = 0;
+    snrSum = 0;
+    snrMin = 0;
+    snrMax = 0;
+    durationMs = 0;
+  }
+
+  float lossPercent() const {
+    uint32_t expected = received + lost;
+    return expected ? 100.0f * lost / expected : 0.0f;
+  }
+
+  float averageSnr() const {
+    return rssiSamples ? snrSum / rssiSamples : 0.0f;
+  }
+
+  int averageRssi() const {
+    return rssiSamples ? (int)(rssiSum / (int32_t)rssiSamples) : 0;
+  }
+};
+
+class LinkStats {
+private:
+  static const int LINK_SEQ_HISTORY = 32;
+
+  LinkWindowStats current;
+  LinkWindowStats lastWindow;
+  LinkWindowStats total;
+  unsigned long windowStart;
+  bool sequenceValid;
+  uint8_t lastSequence;
+  uint32_t seenMask;           // bit i: (lastSequence - i) megérkezett
+  unsigned long lastPacketTime;        // Utolsó érvényes csomag (csend figyelés)
+  unsigned long lastFirstArrivalTime;  // Utolsó új sorszám (ismétlési ablak)
+
+  static void addPhy(LinkWindowStats& stats, int rssi, float snr) {
+    if (!stats.rssiSamples) {
+      stats.rssiMin = stats.rssiMax = rssi;
+      stats.snrMin = stats.snrMax = snr;
+    } else {
+      if (rssi < stats.rssiMin) stats.rssiMin = rssi;
+      if (rssi > stats.rssiMax) stats.rssiMax = rssi;
+      if (snr < stats.snrMin) stats.snrMin = snr;
+      if (snr > stats.snrMax) stats.snrMax = snr;
+    }
+    stats.rssiSamples++;
+    stats.rssiSum += rssi;
+    stats.snrSum += snr;
+  }
+
+  // Új sorozat: a sorszám ablak ettől a csomagtól indul, vesztés nélkül
+  bool startSequence(uint8_t sequence, unsigned long currentTime) {
+    sequenceValid = true;
+    lastSequence = sequence;
+    seenMask = 1;
+    lastFirstArrivalTime = currentTime;
+    current.received++;
+    total.received++;
+    return true;
+  }
+
+  void closeWindow(unsigned long currentTime) {
+    current.durationMs = currentTime - windowStart;
+    lastWindow = current;
+    current.clear();
+    windowStart = currentTime;
+
+    #if DEBUG_ENABLED && DEBUG_LINK
+      print("Link", lastWindow);
+    #endif
+  }
+
+public:
+  LinkStats()
+    : windowStart(0)
+    , sequenceValid(false)
+    , lastSequence(0)
+    , seenMask(0)
+    , lastPacketTime(0)
+    , lastFirstArrivalTime(0) {
+    current.clear();
+    lastWindow.clear();
+    total.clear();
+  }
+
+  // Rendszeresen hívandó (csomag nélkül is), az ablak lezárásához
+  void update(unsigned long currentTime) {
+    if (currentTime - windowStart >= LINK_STATS_WINDOW_MS) {
+      closeWindow(currentTime);
+    }
+  }
+
+  // Minden a rádió által fogadott keret (érvényességtől függetlenül)
+  void recordPhy(int rssi, float snr) {
+    addPhy(current, rssi, snr);
+    addPhy(total, rssi, snr);
+  }
+
+  void recordSizeError() {
+    current.sizeErrors++;
+    total.sizeErrors++;
+  }
+
+  void recordCrcFailure() {
+    current.crcFailures++;
+    total.crcFailures++;
+  }
+
+  void recordFecCorrected() {
+    current.fecCorrected++;
+    total.fecCorrected++;
+  }
+
+  void recordFecUncorrectable() {
+    current.fecUncorrectable++;
+    total.fecUncorrectable++;
+  }
+
+  void recordCopyRescue() {
+    current.rescuedByCopy++;
+    total.rescuedByCopy++;
+  }
+
+  void recordForeign() {
+    current.foreignPackets++;
+    total.foreignPackets++;
+  }
+
+  // Érvényes csomag sorszáma. Visszatérés: true, ha új (nem duplikátum).
+  // Új alapérték (a távirányító újraindulása után a sorszám 0-ról indul):
+  //   - SPEED_EVENT_RESYNC_MS csend után
+  //   - ha egy már látott sorszám első példánya (copyIndex 0) az ismétlési
+  //     ablakon (LINK_REPEAT_WINDOW_MS) túl érkezik
+  bool recordSequence(uint8_t sequence, uint8_t copyIndex, unsigned long currentTime) {
+    bool silent = currentTime - lastPacketTime > SPEED_EVENT_RESYNC_MS;
+    lastPacketTime = currentTime;
+    if (!sequenceValid || silent) {
+      return startSequence(sequence, currentTime);
+    }
+
+    int8_t difference = (int8_t)(sequence - lastSequence);
+
+    if (difference > 0) {
+      uint32_t gap = difference - 1;
+      current.lost += gap;
+      total.lost += gap;
+      seenMask = difference >= LINK_SEQ_HISTORY ? 0 : (seenMask << difference);
+      seenMask |= 1;
+      lastSequence = sequence;
+      lastFirstArrivalTime = currentTime;
+      current.received++;
+      total.received++;
+      return true;
+    }
+
+    int age = -difference;
+    if (age < LINK_SEQ_HISTORY && (seenMask & (1UL << age))) {
+      bool repeat = copyIndex > 0 || currentTime - lastFirstArrivalTime <= LINK_REPEAT_WINDOW_MS;
+      if (!repeat) {
+        #if DEBUG_ENABLED && DEBUG_LINK
+          debugLog.printf("🔄 Sorszám újraszinkron (%u, utolsó: %u)", sequence, lastSequence);
+        #endif
+        return startSequence(sequence, currentTime);
+      }
+      current.duplicates++;
+      total.duplicates++;
+      return false;
+    }
+
+    // Késve érkezett: korábban vesztésnek számoltuk
+    if (age < LINK_SEQ_HISTORY) {
+      seenMask |= 1UL << age;
+    }
+    current.reordered++;
+    total.reordered++;
+    current.received++;
+    total.received++;
+    if (current.lost) current.lost--;
+    if (total.lost) total.lost--;
+    return true;
+  }
+
+  const LinkWindowStats& getLastWindow() const {
+    return lastWindow;
+  }
+
+  const LinkWindowStats& getTotal() const {
+    return total;
+  }
+
+  static void print(const char* label, const LinkWindowStats& stats) {
+    debugLog.printf("📶 %s [%lus] rx:%lu veszt:%.1f%% dup:%lu ism.mentett:%lu csere:%lu crc:%lu idegen:%lu méret:%lu",
+                    label, stats.durationMs / 1000, (unsigned long)stats.received, stats.lossPercent(),
+                    (unsigned long)stats.duplicates, (unsigned long)stats.rescuedByCopy, (unsigned long)stats.reordered,
+                    (unsigned long)stats.crcFailures, (unsigned long)stats.foreignPackets,
+                    (unsigned long)stats.sizeErrors);
+    #if PACKET_FEC
+      debugLog.printf("📶 %s FEC javítva: %lu | javíthatatlan: %lu",
+                      label, (unsigned long)stats.fecCorrected, (unsigned long)stats.fecUncorrectable);
+    #endif
+    if (stats.rssiSamples) {
+      debugLog.printf("📶 %s RSSI: %d (%d..%d) dBm | SNR: %.1f (%.1f..%.1f) dB",
+                      label, stats.averageRssi(), stats.rssiMin, stats.rssiMax,
+                      stats.averageSnr(), stats.snrMin, stats.snrMax);
+    }
+  }
+
+  void dump(unsigned long currentTime) const {
+    print("Utolsó ablak", lastWindow);
+    LinkWindowStats totalSnapshot = total;
+    totalSnapshot.durationMs = currentTime;
+    print("Összesen", totalSnapshot);
+  }
+};
+
+#endif
\ No newline at end of file
@@ -1,151 +1,649 @@
-#ifndef LORA_COMMUNICATION_H
-#define LORA_COMMUNICATION_H
-
-#include <LoRa.h>
-#include <SPI.h>
-#include "settings.h"
-
-enum LoRaState {
-  LORA_OK,
-  LORA_DISCONNECTED,
-  LORA_RECONNECTING
-};
-
-class LoRaCommunication {
-private:
-  LoRaState currentState;
-  unsigned long lastHealthCheck;
-  unsigned long lastReceivedPacket;
-  unsigned long stateChangeTime;
-  int restartCount;
-  bool moduleHealthy;
-
-  void log(const char* message) {
-    #if DEBUG_ENABLED && DEBUG_LORA
-      Serial.println(message);
-    #endif
-  }
-
-  void logHealth(const char* message) {
-    #if DEBUG_ENABLED && DEBUG_HEALTH
-      Serial.println(message);
-    #endif
-  }
-
-public:
-  LoRaCommunication() 
-    : currentState(LORA_OK)
-    , lastHealthCheck(0)
-    , lastReceivedPacket(0)
-    , stateChangeTime(0)
-    , restartCount(0)
-    , moduleHealthy(true) {}
-
-  bool init() {
-    LoRa.setPins(LORA_SS_PIN, LORA_RESET_PIN, LORA_DIO0_PIN);
-    
-    if (!LoRa.begin(LORA_FREQUENCY)) {
-      #if DEBUG_ENABLED && DEBUG_LORA
-        Serial.println("❌ LoRa inicializálás sikertelen!");
-      #endif
-      return false;
-    }
-    
-    pinMode(LORA_RESET_PIN, OUTPUT);
-    digitalWrite(LORA_RESET_PIN, HIGH);
-    
-    log("✅ LoRa inicializálás sikeres");
-    
-    lastHealthCheck = millis();
-    lastReceivedPacket = millis();
-    
-    return true;
-  }
-
-  bool restart() {
-    #if DEBUG_ENABLED && DEBUG_LORA
-      Serial.println("🔄 LoRa modul újraindítása...");
-    #endif
-    
-    LoRa.end();
-    delay(100);
-    digitalWrite(LORA_RESET_PIN, LOW);
-    delay(10);
-    digitalWrite(LORA_RESET_PIN, HIGH);
-    delay(50);
-    
-    bool success = LoRa.begin(LORA_FREQUENCY);
-    if (success) {
-      restartCount++;
-      #if DEBUG_ENABLED && DEBUG_LORA
-        Serial.print("✅ LoRa modul újraindítva (");
-        Serial.print(restartCount);
-        Serial.println(". alkalommal)");
-      #endif
-    } else {
-      log("❌ LoRa modul újraindítása sikertelen!");
-    }
-    return success;
-  }
-
-  void checkHealth() {
-    unsigned long currentTime = millis();
-    
-    if (currentTime - lastHealthCheck < LORA_HEALTH_CHECK_INTERVAL) {
-      return;
-    }
-    
-    lastHealthCheck = currentTime;
-    
-    bool loraWorking = (currentTime - lastReceivedPacket) < LORA_HEALTH_CHECK_INTERVAL;
-    
-    if (!loraWorking && moduleHealthy) {
-      logHealth("⚠️ LoRa: Nincs csomag 5 másodperc alatt - újracsatlakozás...");
-      moduleHealthy = false;
-      currentState = LORA_RECONNECTING;
-      stateChangeTime = currentTime;
-    }
-    
-    if (currentState == LORA_RECONNECTING) {
-      if (currentTime - stateChangeTime > LORA_RECONNECT_TIMEOUT) {
-        logHealth("❌ LoRa újracsatlakozási időtúllépés!");
-        currentState = LORA_DISCONNECTED;
-      } else {
-        if (restart()) {
-          logHealth("✅ LoRa modul sikeresen újracsatlakozott!");
-          moduleHealthy = true;
-          currentState = LORA_OK;
-          lastReceivedPacket = currentTime;
-        } else {
-          delay(1000);
-        }
-      }
-    }
-  }
-
-  int parsePacket() {
-    return LoRa.parsePacket();
-  }
-
-  byte read() {
-    return LoRa.read();
-  }
-
-  void updateReceivedTime() {
-    lastReceivedPacket = millis();
-  }
-
-  unsigned long getLastReceivedTime() const {
-    return lastReceivedPacket;
-  }
-
-  LoRaState getState() const {
-    return currentState;
-  }
-
-  bool isHealthy() const {
-    return moduleHealthy;
-  }
-};
-
+#ifndef LORA_COMMUNICATION_H
+#define LORA_COMMUNICATION_H
+
+#include <LoRa.h>
+#include <SPI.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#include "settings.h"
+#include "lora_phy_profile.h"
+#include "lora_sync_word.h"
+#include "packet_v2.h"
+#include "packet_fec.h"
+#include "sx127x.h"
+#include "debug_log.h"
+
+enum LoRaState {
+  LORA_OK,
+  LORA_DISCONNECTED,
+  LORA_RECONNECTING
+};
+
+// Újraindítási lépések - mindegyik csak néhány µs-ig fut,
+// a várakozások időbélyeg alapján telnek (nincs delay())
+enum LoRaRecoveryStep {
+  RECOVERY_IDLE,
+  RECOVERY_SHUTDOWN,           // end(), majd LORA_SHUTDOWN_SETTLE_MS
+  RECOVERY_RESET_LOW,          // RESET LOW, majd LORA_RESET_PULSE_MS
+  RECOVERY_RESET_HIGH,         // RESET HIGH, majd LORA_RESET_SETTLE_MS
+  RECOVERY_BEGIN,              // begin() (reset nélkül)
+  RECOVERY_BACKOFF             // Sikertelen kísérlet után várakozás
+};
+
+// Egy kiolvasott csomag vételi adatai (readPacket)
+struct LoRaRxInfo {
+  int size;                    // A rádió által jelentett teljes méret
+  int64_t irqTimeUs;           // DIO0 megszakítás (vagy polling) időpontja (esp_timer)
+  int rssi;                    // Csomag RSSI (dBm)
+  float snr;                   // Csomag SNR (dB)
+};
+
+// Egy beérkezett, FIFO-ból már kiolvasott csomag (a vételi queue eleme)
+struct LoRaRxPacket : LoRaRxInfo {
+  byte data[PACKET_V1_AIR_SIZE];
+};
+
+// A rádió: LoRa könyvtár vagy saját SX127x meghajtó (sx127x.h, azonos felület)
+#if LORA_NATIVE_DRIVER
+  inline Sx127x sx127x;
+  static Sx127x& loraRadio = sx127x;
+#else
+  static LoRaClass& loraRadio = LoRa;
+#endif
+
+// A kiválasztott profil légideje a távirányító életjel periódusába és a
+// failsafe ablakba is bele kell férjen (lora_phy_profile.h)
+static_assert(loraPhyProfileFits(LORA_PHY_PROFILE, LORA_FRAME_SIZE, REMOTE_KEEPALIVE_INTERVAL_MS, 1,
+                                 FAILSAFE_TIMEOUT_MS, LORA_IMPLICIT_HEADER),
+              "LORA_PHY_PROFILE légideje nem fér bele az életjel periódusba / failsafe ablakba");
+
+// Implicit fejlécnél a vevőnek előre tudnia kell a keret hosszát (0 = explicit)
+static const int LORA_RX_IMPLICIT_LENGTH = LORA_IMPLICIT_HEADER ? LORA_FRAME_SIZE : 0;
+
+// Idegen robot csomagja már a rádióban elakad (nincs RxDone megszakítás)
+static const uint8_t LORA_SYNC_WORD = loraSyncWord(LORA_SYNC_WORD_PER_ROBOT, ROBOT_ID);
+
+class LoRaCommunication {
+private:
+  LoRaState currentState;
+  unsigned long lastHealthCheck;
+  unsigned long lastReceivedPacket;
+  unsigned long stateChangeTime;
+  int restartCount;
+  bool moduleHealthy;
+  LoRaPhyProfileId phyProfile;
+
+  // Nem blokkoló újraindítás
+  LoRaRecoveryStep recoveryStep;
+  unsigned long stepDeadline;
+  int recoveryAttempts;
+  unsigned long lastRecoveryMs;
+  unsigned long maxRecoveryMs;
+
+  // Megszakításos vétel
+  QueueHandle_t rxQueue;
+  TaskHandle_t rxTaskHandle;
+  SemaphoreHandle_t radioMutex;
+  volatile int64_t lastIrqTimeUs;
+  unsigned long rxLatencyLastUs;
+  unsigned long rxLatencyMaxUs;
+  uint32_t rxQueueDrops;
+
+  // FIFO kiolvasás CPU ideje (csak LATENCY_INSTRUMENTATION)
+  uint32_t fifoReadCount;
+  uint64_t fifoReadTotalUs;
+  uint32_t fifoReadMaxUs;
+
+  static LoRaCommunication* instance;
+
+  void log(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.println(message);
+    #endif
+  }
+
+  void logHealth(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_HEALTH
+      debugLog.println(message);
+    #endif
+  }
+
+  void logPhyProfile() {
+    #if DEBUG_ENABLED && DEBUG_LORA
+      const LoRaPhyProfile& profile = loraPhyProfile(phyProfile);
+      debugLog.printf("📻 PHY profil: %s (SF%u / %lu kHz / 4/%u) | légidő: %lu µs (%d bájt)",
+                      profile.name, profile.spreadingFactor, (unsigned long)(profile.bandwidthHz / 1000),
+                      profile.codingRateDenominator,
+                      (unsigned long)loraTimeOnAirUs(profile, LORA_FRAME_SIZE, LORA_IMPLICIT_HEADER), LORA_FRAME_SIZE);
+    #endif
+  }
+
+  // DIO0 (RxDone) megszakítás - csak időbélyeg + task értesítés,
+  // az SPI olvasás a vételi taskban történik
+  static void IRAM_ATTR onDio0Rise() {
+    if (!instance || !instance->rxTaskHandle) {
+      return;
+    }
+    instance->lastIrqTimeUs = esp_timer_get_time();
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(instance->rxTaskHandle, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) {
+      portYIELD_FROM_ISR();
+    }
+  }
+
+  static void rxTaskEntry(void* parameter) {
+    static_cast<LoRaCommunication*>(parameter)->rxTaskLoop();
+  }
+
+  void rxTaskLoop() {
+    for (;;) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+      LoRaRxPacket packet;
+      bool received = readPacket(packet.data, sizeof(packet.data), packet);
+
+      if (received && xQueueSend(rxQueue, &packet, 0) != pdTRUE) {
+        rxQueueDrops++;
+      }
+    }
+  }
+
+  #if LORA_NATIVE_DRIVER
+    // Státusz blokk + FIFO burst, a modul folyamatos vételen marad
+    int readFifo(uint8_t* buffer, size_t capacity, LoRaRxInfo& info) {
+      loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);  // Polling módban indítja, egyébként nem ír regisztert
+      info.size = loraRadio.readPacket(buffer, capacity, info.rssi, info.snr);
+      if (info.size <= 0) {
+        return 0;
+      }
+      return (size_t)info.size < capacity ? info.size : (int)capacity;
+    }
+  #else
+    // Regiszterek folyamatos olvasása egyetlen SPI tranzakcióban
+    // (a cím a FIFO-nál nem lép, így a teljes payload egy burst)
+    static void burstRead(uint8_t address, uint8_t* buffer, size_t length) {
+      SPI.beginTransaction(SPISettings(LORA_DEFAULT_SPI_FREQUENCY, MSBFIRST, SPI_MODE0));
+      digitalWrite(LORA_SS_PIN, LOW);
+      SPI.transfer(address & 0x7F);
+      SPI.transfer(buffer, length);
+      digitalWrite(LORA_SS_PIN, HIGH);
+      SPI.endTransaction();
+    }
+
+    // A parsePacket a FIFO mutatót már a csomag elejére állította
+    int readFifo(uint8_t* buffer, size_t capacity, LoRaRxInfo& info) {
+      info.size = loraRadio.parsePacket(LORA_RX_IMPLICIT_LENGTH);
+      if (info.size <= 0) {
+        return 0;
+      }
+      int bytesToRead = (size_t)info.size < capacity ? info.size : (int)capacity;
+
+      #if LORA_BURST_FIFO_READ
+        burstRead(SX127X_REG_FIFO, buffer, bytesToRead);
+        uint8_t signal[2];
+        burstRead(SX127X_REG_PKT_SNR_VALUE, signal, sizeof(signal));
+        info.snr = (int8_t)signal[0] * 0.25f;
+        info.rssi = signal[1] - (LORA_FREQUENCY < SX127X_MID_BAND_THRESHOLD ? SX127X_RSSI_OFFSET_LF : SX127X_RSSI_OFFSET_HF);
+      #else
+        for (int i = 0; i < bytesToRead; i++) {
+          buffer[i] = loraRadio.read();
+        }
+        info.rssi = loraRadio.packetRssi();
+        info.snr = loraRadio.packetSnr();
+      #endif
+      return bytesToRead;
+    }
+  #endif
+
+  // A saját meghajtó maga kezeli a DIO0-t (TxDone is), csak az RxDone jön ide
+  void attachRxInterrupt() {
+    #if LORA_NATIVE_DRIVER
+      loraRadio.onRxDone(onDio0Rise);
+    #else
+      attachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN), onDio0Rise, RISING);
+    #endif
+  }
+
+  void detachRxInterrupt() {
+    #if LORA_NATIVE_DRIVER
+      loraRadio.onRxDone(nullptr);
+    #else
+      detachInterrupt(digitalPinToInterrupt(LORA_DIO0_PIN));
+    #endif
+  }
+
+  void recordFifoReadTime(uint32_t elapsedUs) {
+    fifoReadCount++;
+    fifoReadTotalUs += elapsedUs;
+    if (elapsedUs > fifoReadMaxUs) {
+      fifoReadMaxUs = elapsedUs;
+    }
+  }
+
+  void stepRecovery(unsigned long currentTime) {
+    if ((long)(currentTime - stepDeadline) < 0) {
+      return;
+    }
+    
+    switch (recoveryStep) {
+      case RECOVERY_SHUTDOWN:
+        #if DEBUG_ENABLED && DEBUG_LORA
+          debugLog.printf("🔄 LoRa modul újraindítása... (%d/%d. kísérlet)",
+                          recoveryAttempts + 1, MAX_LORA_RESTARTS);
+        #endif
+        xSemaphoreTake(radioMutex, portMAX_DELAY);
+        #if LORA_RX_INTERRUPT_MODE
+          detachRxInterrupt();
+        #endif
+        loraRadio.end();
+        xSemaphoreGive(radioMutex);
+        stepDeadline = currentTime + LORA_SHUTDOWN_SETTLE_MS;
+        recoveryStep = RECOVERY_RESET_LOW;
+        break;
+        
+      case RECOVERY_RESET_LOW:
+        digitalWrite(LORA_RESET_PIN, LOW);
+        stepDeadline = currentTime + LORA_RESET_PULSE_MS;
+        recoveryStep = RECOVERY_RESET_HIGH;
+        break;
+        
+      case RECOVERY_RESET_HIGH:
+        digitalWrite(LORA_RESET_PIN, HIGH);
+        stepDeadline = currentTime + LORA_RESET_SETTLE_MS;
+        recoveryStep = RECOVERY_BEGIN;
+        break;
+        
+      case RECOVERY_BEGIN:
+        if (beginAfterReset()) {
+          finishRecovery(currentTime);
+        } else {
+          recoveryAttempts++;
+          log("❌ LoRa modul újraindítása sikertelen!");
+          if (recoveryAttempts >= MAX_LORA_RESTARTS ||
+              currentTime - stateChangeTime > LORA_RECONNECT_TIMEOUT) {
+            #if DEBUG_ENABLED && DEBUG_HEALTH
+              debugLog.printf("❌ LoRa újracsatlakozás feladva %d kísérlet / %lu ms után!",
+                              recoveryAttempts, currentTime - stateChangeTime);
+            #endif
+            currentState = LORA_DISCONNECTED;
+            stateChangeTime = currentTime;
+            recoveryStep = RECOVERY_IDLE;
+          } else {
+            stepDeadline = currentTime + LORA_RESTART_BACKOFF_MS;
+            recoveryStep = RECOVERY_BACKOFF;
+          }
+        }
+        break;
+        
+      case RECOVERY_BACKOFF:
+        recoveryStep = RECOVERY_SHUTDOWN;
+        break;
+        
+      case RECOVERY_IDLE:
+        break;
+    }
+  }
+
+  // A hardveres resetet már a lépések elvégezték, ezért a könyvtár
+  // saját (delay-es) resetjét kikapcsoljuk
+  bool beginAfterReset() {
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    loraRadio.setPins(LORA_SS_PIN, -1, LORA_DIO0_PIN);
+    #if LORA_NATIVE_DRIVER
+      loraRadio.setSpiPins(LORA_SCK_PIN, LORA_MISO_PIN, LORA_MOSI_PIN);
+    #endif
+    bool success = loraRadio.begin(LORA_FREQUENCY);
+    if (success) {
+      applyLoRaPhyProfile(loraRadio, loraPhyProfile(phyProfile));
+      loraRadio.setSyncWord(LORA_SYNC_WORD);
+    }
+    
+    #if LORA_RX_INTERRUPT_MODE
+      if (success) {
+        loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+        attachRxInterrupt();
+      }
+    #endif
+    
+    xSemaphoreGive(radioMutex);
+    return success;
+  }
+
+  void finishRecovery(unsigned long currentTime) {
+    restartCount++;
+    lastRecoveryMs = currentTime - stateChangeTime;
+    if (lastRecoveryMs > maxRecoveryMs) {
+      maxRecoveryMs = lastRecoveryMs;
+    }
+    
+    #if DEBUG_ENABLED && DEBUG_HEALTH
+      debugLog.printf("✅ LoRa modul újracsatlakozott %lu ms alatt (%d. kísérlet, összesen %d. alkalommal, max: %lu ms)",
+                      lastRecoveryMs, recoveryAttempts + 1, restartCount, maxRecoveryMs);
+    #endif
+    
+    moduleHealthy = true;
+    currentState = LORA_OK;
+    stateChangeTime = currentTime;
+    lastReceivedPacket = currentTime;
+    lastHealthCheck = currentTime;
+    recoveryStep = RECOVERY_IDLE;
+  }
+
+  bool startInterruptRx() {
+    rxQueue = xQueueCreate(LORA_RX_QUEUE_LENGTH, sizeof(LoRaRxPacket));
+    if (!rxQueue) {
+      log("❌ LoRa vételi queue létrehozása sikertelen!");
+      return false;
+    }
+
+    if (xTaskCreatePinnedToCore(rxTaskEntry, "LoRaRx", LORA_RX_TASK_STACK, this,
+                                LORA_RX_TASK_PRIORITY, &rxTaskHandle, LORA_RX_TASK_CORE) != pdPASS) {
+      log("❌ LoRa vételi task indítása sikertelen!");
+      return false;
+    }
+
+    loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+    attachRxInterrupt();
+
+    log("✅ LoRa megszakításos vétel aktív (DIO0)");
+    return true;
+  }
+
+public:
+  LoRaCommunication() 
+    : currentState(LORA_OK)
+    , lastHealthCheck(0)
+    , lastReceivedPacket(0)
+    , stateChangeTime(0)
+    , restartCount(0)
+    , moduleHealthy(true)
+    , phyProfile(LORA_PHY_PROFILE)
+    , recoveryStep(RECOVERY_IDLE)
+    , stepDeadline(0)
+    , recoveryAttempts(0)
+    , lastRecoveryMs(0)
+    , maxRecoveryMs(0)
+    , rxQueue(nullptr)
+    , rxTaskHandle(nullptr)
+    , radioMutex(nullptr)
+    , lastIrqTimeUs(0)
+    , rxLatencyLastUs(0)
+    , rxLatencyMaxUs(0)
+    , rxQueueDrops(0)
+    , fifoReadCount(0)
+    , fifoReadTotalUs(0)
+    , fifoReadMaxUs(0) {
+    instance = this;
+  }
+
+  bool init() {
+    loraRadio.setPins(LORA_SS_PIN, LORA_RESET_PIN, LORA_DIO0_PIN);
+    #if LORA_NATIVE_DRIVER
+      loraRadio.setSpiPins(LORA_SCK_PIN, LORA_MISO_PIN, LORA_MOSI_PIN);
+    #endif
+    
+    if (!loraRadio.begin(LORA_FREQUENCY)) {
+      #if DEBUG_ENABLED && DEBUG_LORA
+        debugLog.println("❌ LoRa inicializálás sikertelen!");
+      #endif
+      return false;
+    }
+    
+    applyLoRaPhyProfile(loraRadio, loraPhyProfile(phyProfile));
+    loraRadio.setSyncWord(LORA_SYNC_WORD);
+    
+    pinMode(LORA_RESET_PIN, OUTPUT);
+    digitalWrite(LORA_RESET_PIN, HIGH);
+    
+    log("✅ LoRa inicializálás sikeres");
+    logPhyProfile();
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.printf("📻 Szinkron szó: 0x%02X", LORA_SYNC_WORD);
+    #endif
+    
+    radioMutex = xSemaphoreCreateMutex();
+    if (!radioMutex) {
+      log("❌ LoRa mutex létrehozása sikertelen!");
+      return false;
+    }
+    
+    #if LORA_RX_INTERRUPT_MODE
+      if (!startInterruptRx()) {
+        return false;
+      }
+    #endif
+    
+    lastHealthCheck = millis();
+    lastReceivedPacket = millis();
+    
+    return true;
+  }
+
+  // Újraindítási folyamat indítása (nem blokkol, a lépéseket checkHealth() hajtja)
+  void startRecovery() {
+    if (recoveryStep != RECOVERY_IDLE) {
+      return;
+    }
+    moduleHealthy = false;
+    currentState = LORA_RECONNECTING;
+    stateChangeTime = millis();
+    recoveryAttempts = 0;
+    // Az előző folyamat határideje régi lehet: a leállítás azonnal indul
+    // (egy millis() túlcsordulás közeli érték nem késleltetheti ~24 napig)
+    stepDeadline = stateChangeTime;
+    recoveryStep = RECOVERY_SHUTDOWN;
+  }
+
+  void checkHealth() {
+    unsigned long currentTime = millis();
+    
+    // ===== FOLYAMATBAN LÉVŐ ÚJRAINDÍTÁS LÉPTETÉSE =====
+    if (recoveryStep != RECOVERY_IDLE) {
+      stepRecovery(currentTime);
+      return;
+    }
+    
+    if (currentTime - lastHealthCheck < LORA_HEALTH_CHECK_INTERVAL) {
+      return;
+    }
+    
+    lastHealthCheck = currentTime;
+    
+    #if DEBUG_ENABLED && DEBUG_HEALTH && LORA_RX_INTERRUPT_MODE
+      debugLog.printf("📊 LoRa vételi késleltetés - utolsó: %lu µs | max: %lu µs | eldobott: %lu",
+                      rxLatencyLastUs, rxLatencyMaxUs, (unsigned long)rxQueueDrops);
+    #endif
+    
+    // ===== SZÉTKAPCSOLT ÁLLAPOT: ÚJ KÍSÉRLET TIMEOUT UTÁN =====
+    if (currentState == LORA_DISCONNECTED) {
+      if (currentTime - stateChangeTime >= LORA_RECONNECT_TIMEOUT) {
+        logHealth("🔄 LoRa: új újracsatlakozási sorozat...");
+        startRecovery();
+      }
+      return;
+    }
+    
+    bool loraWorking = (currentTime - lastReceivedPacket) < LORA_HEALTH_CHECK_INTERVAL;
+    
+    if (!loraWorking && moduleHealthy) {
+      logHealth("⚠️ LoRa: Nincs csomag 5 másodperc alatt - újracsatlakozás...");
+      startRecovery();
+    }
+  }
+
+  bool isRecovering() const {
+    return recoveryStep != RECOVERY_IDLE;
+  }
+
+  // Következő csomag átvétele.
+  // Megszakításos módban legfeljebb 'timeout' ideig blokkol a queue-n,
+  // polling módban azonnal visszatér.
+  bool receivePacket(LoRaRxPacket& packet, TickType_t timeout) {
+    #if LORA_RX_INTERRUPT_MODE
+      if (xQueueReceive(rxQueue, &packet, timeout) != pdTRUE) {
+        return false;
+      }
+      rxLatencyLastUs = (unsigned long)(esp_timer_get_time() - packet.irqTimeUs);
+      if (rxLatencyLastUs > rxLatencyMaxUs) {
+        rxLatencyMaxUs = rxLatencyLastUs;
+      }
+      return true;
+    #else
+      return readPacket(packet.data, sizeof(packet.data), packet);
+    #endif
+  }
+
+  // Egy csomag kiolvasása a rádióból: payload (legfeljebb 'capacity' bájt),
+  // RSSI, SNR és a vétel időbélyege. Megszakításos módban a vételi task hívja,
+  // utána a folyamatos vétel újraélesítve. Visszatérés: volt-e csomag.
+  bool readPacket(uint8_t* buffer, size_t capacity, LoRaRxInfo& info) {
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    #if LORA_RX_INTERRUPT_MODE
+      info.irqTimeUs = lastIrqTimeUs;
+    #else
+      info.irqTimeUs = esp_timer_get_time();
+    #endif
+
+    #if LATENCY_INSTRUMENTATION
+      int64_t readStartUs = esp_timer_get_time();
+    #endif
+    bool received = readFifo(buffer, capacity, info) > 0;
+    #if LATENCY_INSTRUMENTATION
+      if (received) {
+        recordFifoReadTime((uint32_t)(esp_timer_get_time() - readStartUs));
+      }
+    #endif
+
+    #if LORA_RX_INTERRUPT_MODE
+      // Folyamatos vétel újraélesítése (a parsePacket idle módba teszi a modult)
+      loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+    #endif
+    xSemaphoreGive(radioMutex);
+    return received;
+  }
+
+  // Csomagonkénti FIFO kiolvasási idő (parsePacket + payload + RSSI/SNR)
+  void dumpFifoReadTime() const {
+    debugLog.printf("⏲️ FIFO kiolvasás (%s): n=%lu | átlag: %lu µs | max: %lu µs",
+                    LORA_NATIVE_DRIVER ? "SX127x meghajtó" : (LORA_BURST_FIFO_READ ? "SPI burst" : "bájtonként"),
+                    (unsigned long)fifoReadCount,
+                    (unsigned long)(fifoReadCount ? fifoReadTotalUs / fifoReadCount : 0),
+                    (unsigned long)fifoReadMaxUs);
+  }
+
+  void updateReceivedTime() {
+    lastReceivedPacket = millis();
+  }
+
+  unsigned long getLastReceivedTime() const {
+    return lastReceivedPacket;
+  }
+
+  unsigned long getRxLatencyLastUs() const {
+    return rxLatencyLastUs;
+  }
+
+  unsigned long getRxLatencyMaxUs() const {
+    return rxLatencyMaxUs;
+  }
+
+  uint32_t getRxQueueDrops() const {
+    return rxQueueDrops;
+  }
+
+  unsigned long getLastRecoveryMs() const {
+    return lastRecoveryMs;
+  }
+
+  unsigned long getMaxRecoveryMs() const {
+    return maxRecoveryMs;
+  }
+
+  // Változáskor a távirányító által adott keretek száma (első + ismétlések),
+  // a távirányító RepeatSettings::framesPerChange() értékével azonos
+  static constexpr int remoteFramesPerChange(LoRaPhyProfileId profile) {
+    return 1 + (profile == LORA_PROFILE_LOWEST_LATENCY ? REMOTE_REPEAT_COPIES_LOWEST_LATENCY
+                : profile == LORA_PROFILE_BALANCED   ? REMOTE_REPEAT_COPIES_BALANCED
+                                                     : REMOTE_REPEAT_COPIES_LONG_RANGE);
+  }
+
+  static constexpr bool phyProfileFits(LoRaPhyProfileId profile) {
+    return loraPhyProfileFits(profile, LORA_FRAME_SIZE, REMOTE_KEEPALIVE_INTERVAL_MS, remoteFramesPerChange(profile),
+                              FAILSAFE_TIMEOUT_MS, LORA_IMPLICIT_HEADER);
+  }
+
+  // Rövid vezérlő keret küldése (blokkol a légidő végéig), utána vissza vételre.
+  // A DIO0 közben TxDone-t jelez - a vételi task ezt üres FIFO-ként kezeli.
+  bool transmitFrame(const uint8_t* frame, int length) {
+    if (currentState != LORA_OK) {
+      return false;
+    }
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    bool success = loraRadio.beginPacket(LORA_IMPLICIT_HEADER) && loraRadio.write(frame, length) == (size_t)length && loraRadio.endPacket();
+    #if LORA_RX_INTERRUPT_MODE
+      loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+    #endif
+    xSemaphoreGive(radioMutex);
+    return success;
+  }
+
+  // TDMA: vevő kikapcsolása a saját időrésen kívül / bekapcsolása előtte
+  void sleepRx() {
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    loraRadio.sleep();
+    xSemaphoreGive(radioMutex);
+  }
+
+  void startRx() {
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+    xSemaphoreGive(radioMutex);
+  }
+
+  // PHY profil váltás futás közben. A légidő ellenőrzésen elbukó
+  // profilt elutasítja (a távirányítónak ugyanarra kell váltania).
+  bool setPhyProfile(LoRaPhyProfileId profile) {
+    if (profile < 0 || profile >= LORA_PROFILE_COUNT) {
+      return false;
+    }
+    if (!phyProfileFits(profile)) {
+      #if DEBUG_ENABLED && DEBUG_LORA
+        debugLog.printf("❌ PHY profil elutasítva: %s (légidő: %lu µs)", loraPhyProfile(profile).name,
+                        (unsigned long)loraTimeOnAirUs(loraPhyProfile(profile), LORA_FRAME_SIZE, LORA_IMPLICIT_HEADER));
+      #endif
+      return false;
+    }
+    
+    xSemaphoreTake(radioMutex, portMAX_DELAY);
+    applyLoRaPhyProfile(loraRadio, loraPhyProfile(profile));
+    #if LORA_RX_INTERRUPT_MODE
+      loraRadio.receive(LORA_RX_IMPLICIT_LENGTH);
+    #endif
+    phyProfile = profile;
+    xSemaphoreGive(radioMutex);
+    
+    logPhyProfile();
+    return true;
+  }
+
+  LoRaPhyProfileId getPhyProfile() const {
+    return phyProfile;
+  }
+
+  LoRaState getState() const {
+    return currentState;
+  }
+
+  bool isHealthy() const {
+    return moduleHealthy;
+  }
+};
+
+// Static instance pointer inicializálása
+LoRaCommunication* LoRaCommunication::instance = nullptr;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#ifndef LORA_PHY_PROFILE_H
+#define LORA_PHY_PROFILE_H
+
+#include <stdint.h>
+#include <LoRa.h>
+
+// ═════════════════════════════════════════════════════════
+// LoRa PHY PROFILOK (KÖZÖS: TÁVIRÁNYÍTÓ + MOTORVEZÉRLŐ)
+// ═════════════════════════════════════════════════════════
+// Mindkét oldalnak ugyanazt a profilt kell használnia, különben nem
+// hallják egymást. A BALANCED profil megegyezik a LoRa könyvtár
+// alapbeállításaival (SF7 / 125 kHz / 4/5 / 8 szimbólum preambulum).
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+enum LoRaPhyProfileId {
+  LORA_PROFILE_LOWEST_LATENCY,
+  LORA_PROFILE_BALANCED,
+  LORA_PROFILE_LONG_RANGE,
+  LORA_PROFILE_COUNT
+};
+
+struct LoRaPhyProfile {
+  const char* name;
+  uint8_t spreadingFactor;       // 7..12
+  uint32_t bandwidthHz;
+  uint8_t codingRateDenominator; // 5..8 (4/5 .. 4/8)
+  uint16_t preambleLength;       // Szimbólum
+  bool crcEnabled;               // Hardveres CRC (a csomagban saját CRC16 is van)
+};
+
+constexpr LoRaPhyProfile LORA_PHY_PROFILES[LORA_PROFILE_COUNT] = {
+  { "legkisebb késés", 7, 500000, 5, 8, false },
+  { "kiegyensúlyozott", 7, 125000, 5, 8, false },
+  { "nagy hatótáv",    10, 125000, 8, 8, false },
+};
+
+constexpr const LoRaPhyProfile& loraPhyProfile(LoRaPhyProfileId id) {
+  return LORA_PHY_PROFILES[id];
+}
+
+// Szimbólumidő 16 ms felett kötelező az alacsony adatsebesség optimalizálás
+constexpr bool loraLowDataRateOptimize(const LoRaPhyProfile& profile) {
+  return ((uint64_t)1000000 << profile.spreadingFactor) / profile.bandwidthHz > 16000;
+}
+
+// Demodulációs SNR küszöb (dB) a Semtech SX1276 adatlap szerint:
+// SF7: -7.5 ... SF12: -20 (2.5 dB-es lépések)
+constexpr float loraDemodFloorDb(uint8_t spreadingFactor) {
+  return -7.5f - 2.5f * (spreadingFactor - 7);
+}
+
+// Légidő (µs) a Semtech AN1200.13 képlete szerint:
+//   T_sym = 2^SF / BW
+//   T_preambulum = (N_preambulum + 4.25) * T_sym
+//   N_payload = 8 + max(ceil((8PL - 4SF + 28 + 16CRC - 20IH) / (4(SF - 2DE))) * (CR + 4), 0)
+// Az implicit fejléc módot a könyvtár csomagonként állítja (beginPacket / parsePacket).
+constexpr uint32_t loraTimeOnAirUs(const LoRaPhyProfile& profile, int payloadLength, bool implicitHeader = false) {
+  const int sf = profile.spreadingFactor;
+  const int de = loraLowDataRateOptimize(profile) ? 1 : 0;
+  const int numerator = 8 * payloadLength - 4 * sf + 28
+                        + (profile.crcEnabled ? 16 : 0)
+                        - (implicitHeader ? 20 : 0);
+  const int denominator = 4 * (sf - 2 * de);
+  const int blocks = numerator > 0 ? (numerator + denominator - 1) / denominator : 0;
+  const uint32_t payloadSymbols = 8 + blocks * profile.codingRateDenominator;
+
+  // Negyed szimbólumokban számolva, hogy a 4.25 egész maradjon
+  const uint64_t quarterSymbols = 4ULL * (profile.preambleLength + payloadSymbols) + 17;
+  return (uint32_t)((quarterSymbols * (1000000ULL << sf) / 4) / profile.bandwidthHz);
+}
+
+// Alkalmazható-e a profil az adott időzítéssel:
+//   - framesPerPeriod keret (változás + ismétlések) belefér az adási periódusba
+//   - a failsafe ablakon belül legalább LORA_MIN_FRAMES_PER_FAILSAFE keret érkezhet
+constexpr int LORA_MIN_FRAMES_PER_FAILSAFE = 2;
+
+constexpr bool loraPhyProfileFits(LoRaPhyProfileId id, int frameLength, uint32_t transmitPeriodMs,
+                                  int framesPerPeriod, uint32_t failsafeTimeoutMs, bool implicitHeader = false) {
+  const uint32_t airtimeUs = loraTimeOnAirUs(loraPhyProfile(id), frameLength, implicitHeader);
+  return (uint64_t)airtimeUs * framesPerPeriod <= transmitPeriodMs * 1000ULL
+      && (uint64_t)LORA_MIN_FRAMES_PER_FAILSAFE * (transmitPeriodMs * 1000ULL + airtimeUs)
+           <= failsafeTimeoutMs * 1000ULL;
+}
+
+// A begin() után hívandó (a begin visszaállítja az alapértékeket).
+// A modem beállítások készenléti módban íródnak, utána a hívó állítja vissza a vételt.
+// A Radio a LoRa könyvtár vagy a saját SX127x meghajtó (sx127x.h) - azonos felület.
+template <typename Radio>
+inline void applyLoRaPhyProfile(Radio& radio, const LoRaPhyProfile& profile) {
+  radio.idle();
+  radio.setSpreadingFactor(profile.spreadingFactor);
+  radio.setSignalBandwidth(profile.bandwidthHz);
+  radio.setCodingRate4(profile.codingRateDenominator);
+  radio.setPreambleLength(profile.preambleLength);
+  if (profile.crcEnabled) {
+    radio.enableCrc();
+  } else {
+    radio.disableCrc();
+  }
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef MOTOR_COMMAND_TABLE_H
+#define MOTOR_COMMAND_TABLE_H
+
+#include <stdint.h>
+
+// ═════════════════════════════════════════════════════════
+// MOTOR PARANCS → KITÖLTÉS TÁBLÁZAT (FORDÍTÁSI IDEJŰ)
+// ═════════════════════════════════════════════════════════
+// A 4 bites gomb parancs (0b0001 bal előre, 0b0010 bal hátra, 0b0100 jobb
+// előre, 0b1000 jobb hátra) mind a 16 értékéhez, sebesség fokozatonként
+// előre kiszámolt előjeles kerék kitöltés. Egy oldal előre + hátra bitje
+// együtt érvénytelen: a bejegyzés 0/0 kitöltés, valid = false.
+// A MotorControl végrehajtása így egyetlen táblázat olvasás.
+#define MOTOR_COMMAND_COUNT 16
+
+struct CommandDuty {
+  int16_t left;                // Előjeles kitöltés (+ előre, - hátra)
+  int16_t right;
+  bool valid;
+};
+
+template <int LevelCount>
+struct CommandTable {
+  CommandDuty entries[LevelCount][MOTOR_COMMAND_COUNT];
+};
+
+constexpr bool isValidMotorCommand(int command) {
+  return (command & 0b0011) != 0b0011 && (command & 0b1100) != 0b1100;
+}
+
+constexpr int commandSideDuty(bool forward, bool backward, int speed) {
+  return forward ? speed : (backward ? -speed : 0);
+}
+
+template <int... SpeedLevels>
+constexpr CommandTable<sizeof...(SpeedLevels)> buildCommandTable() {
+  CommandTable<sizeof...(SpeedLevels)> table = {};
+  const int speeds[] = {SpeedLevels...};
+  for (int level = 0; level < (int)sizeof...(SpeedLevels); level++) {
+    for (int command = 0; command < MOTOR_COMMAND_COUNT; command++) {
+      if (!isValidMotorCommand(command)) {
+        table.entries[level][command] = CommandDuty{0, 0, false};
+        continue;
+      }
+      table.entries[level][command] = CommandDuty{
+        (int16_t)commandSideDuty(command & 0b0001, command & 0b0010, speeds[level]),
+        (int16_t)commandSideDuty(command & 0b0100, command & 0b1000, speeds[level]),
+        true
+      };
+    }
+  }
+  return table;
+}
+
+// static_assert-hoz: minden bejegyzés egyezik a bitek jelentésével, az
+// érvénytelen kombinációk (mindkét oldalon 4-4) álló, valid = false bejegyzések
+template <int LevelCount>
+constexpr bool commandTableConsistent(const CommandTable<LevelCount>& table, const int (&speeds)[LevelCount]) {
+  int invalidCount = 0;
+  for (int level = 0; level < LevelCount; level++) {
+    for (int command = 0; command < MOTOR_COMMAND_COUNT; command++) {
+      const CommandDuty& entry = table.entries[level][command];
+      bool leftConflict = (command & 0b0001) && (command & 0b0010);
+      bool rightConflict = (command & 0b0100) && (command & 0b1000);
+      if (leftConflict || rightConflict) {
+        if (entry.valid || entry.left != 0 || entry.right != 0) {
+          return false;
+        }
+        invalidCount++;
+        continue;
+      }
+      int speed = speeds[level];
+      if (!entry.valid ||
+          entry.left != ((command & 0b0001) ? speed : (command & 0b0010) ? -speed : 0) ||
+          entry.right != ((command & 0b0100) ? speed : (command & 0b1000) ? -speed : 0)) {
+        return false;
+      }
+    }
+  }
+  return invalidCount == 7 * LevelCount;
+}
+
+#endif
\ No newline at end of file
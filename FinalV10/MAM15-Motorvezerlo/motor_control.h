@@ -1,136 +1,236 @@
-#ifndef MOTOR_CONTROL_H
-#define MOTOR_CONTROL_H
-
-#include <Arduino.h>
-#include "settings.h"
-
-class MotorControl {
-private:
-  int speedLevels[3];
-  int currentSpeedLevelIndex;
-  bool previousSpeedButtonState;
-
-  void log(const char* message) {
-    #if DEBUG_ENABLED && DEBUG_MOTOR
-      Serial.println(message);
-    #endif
-  }
-
-public:
-  MotorControl() : currentSpeedLevelIndex(0), previousSpeedButtonState(false) {
-    speedLevels[0] = SPEED_LEVEL_1;
-    speedLevels[1] = SPEED_LEVEL_2;
-    speedLevels[2] = SPEED_LEVEL_3;
-  }
-
-  bool init() {
-    bool pwmSetupSuccessful = true;
-    
-    if (!ledcAttach(LEFT_MOTOR_FORWARD_PIN, PWM_FREQUENCY, PWM_RESOLUTION)) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ Bal motor előre PWM inicializálás sikertelen!");
-      #endif
-      pwmSetupSuccessful = false;
-    }
-    
-    if (!ledcAttach(LEFT_MOTOR_REVERSE_PIN, PWM_FREQUENCY, PWM_RESOLUTION)) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ Bal motor hátra PWM inicializálás sikertelen!");
-      #endif
-      pwmSetupSuccessful = false;
-    }
-    
-    if (!ledcAttach(RIGHT_MOTOR_FORWARD_PIN, PWM_FREQUENCY, PWM_RESOLUTION)) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ Jobb motor előre PWM inicializálás sikertelen!");
-      #endif
-      pwmSetupSuccessful = false;
-    }
-    
-    if (!ledcAttach(RIGHT_MOTOR_REVERSE_PIN, PWM_FREQUENCY, PWM_RESOLUTION)) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ Jobb motor hátra PWM inicializálás sikertelen!");
-      #endif
-      pwmSetupSuccessful = false;
-    }
-    
-    if (pwmSetupSuccessful) {
-      log("✅ PWM inicializálás sikeres");
-    }
-    
-    return pwmSetupSuccessful;
-  }
-
-  void control(bool leftForward, bool leftBackward, bool rightForward, bool rightBackward) {
-    int currentSpeed = speedLevels[currentSpeedLevelIndex];
-    
-    ledcWrite(LEFT_MOTOR_FORWARD_PIN, leftForward ? currentSpeed : 0);
-    ledcWrite(LEFT_MOTOR_REVERSE_PIN, leftBackward ? currentSpeed : 0);
-    ledcWrite(RIGHT_MOTOR_FORWARD_PIN, rightForward ? currentSpeed : 0);
-    ledcWrite(RIGHT_MOTOR_REVERSE_PIN, rightBackward ? currentSpeed : 0);
-  }
-
-  void stop() {
-    control(false, false, false, false);
-    
-    #if DEBUG_ENABLED && DEBUG_MOTOR
-      Serial.println("🛑 Motorok leállítva");
-    #endif
-  }
-
-  bool validateCommand(byte command) {
-    bool leftConflict = (command & 0b0001) && (command & 0b0010);
-    bool rightConflict = (command & 0b0100) && (command & 0b1000);
-    
-    if (leftConflict) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ ÉRVÉNYTELEN: Bal motor egyszerre előre és hátra!");
-      #endif
-      return false;
-    }
-    
-    if (rightConflict) {
-      #if DEBUG_ENABLED && DEBUG_MOTOR
-        Serial.println("❌ ÉRVÉNYTELEN: Jobb motor egyszerre előre és hátra!");
-      #endif
-      return false;
-    }
-    
-    return true;
-  }
-
-  void handleSpeedButton(bool speedButtonPressed) {
-    if (speedButtonPressed && !previousSpeedButtonState) {
-      int previousSpeed = speedLevels[currentSpeedLevelIndex];
-      currentSpeedLevelIndex = (currentSpeedLevelIndex + 1) % 3;
-      
-      #if DEBUG_ENABLED && DEBUG_SPEED
-        Serial.print("⚡ Sebesség váltás: ");
-        Serial.print(previousSpeed);
-        Serial.print(" → ");
-        Serial.println(speedLevels[currentSpeedLevelIndex]);
-      #endif
-    }
-    previousSpeedButtonState = speedButtonPressed;
-  }
-
-  void executeCommand(byte motorCommand) {
-    if (!validateCommand(motorCommand)) {
-      stop();
-      return;
-    }
-    
-    if (motorCommand == 0) {
-      stop();
-    } else {
-      control(
-        motorCommand & 0b0001,
-        motorCommand & 0b0010,
-        motorCommand & 0b0100,
-        motorCommand & 0b1000
-      );
-    }
-  }
-};
-
+#ifndef MOTOR_CONTROL_H
+#define MOTOR_CONTROL_H
+
+#include <Arduino.h>
+#include "settings.h"
+#include "debug_log.h"
+#include "motor_slew.h"
+#include "drive_mixer.h"
+#include "motor_pwm.h"
+#include "wheel_speed_control.h"
+#include "motor_command_table.h"
+
+// Fokozatonkénti gyorsítási rámpa (ms), a SpeedLevels sorrendjében
+constexpr int SPEED_LEVEL_RAMPS_MS[] = {SPEED_LEVEL_1_RAMP_MS, SPEED_LEVEL_2_RAMP_MS, SPEED_LEVEL_3_RAMP_MS};
+
+// ═════════════════════════════════════════════════════════
+// MOTORVEZÉRLÉS (FORDÍTÁSI IDEJŰ LÁBAK ÉS SEBESSÉG FOKOZATOK)
+// ═════════════════════════════════════════════════════════
+// PinSet: a H-híd lábai (pl. RobotMotorPins), SpeedLevels: a fokozatok
+// kitöltése (0-255). A gomb parancs → kitöltés táblázat (motor_command_table.h)
+// és a rámpa lépések fordításkor készülnek és ellenőrződnek, a végrehajtás
+// egy táblázat olvasás + kitöltés írás.
+template <typename PinSet, int... SpeedLevels>
+class MotorControl {
+private:
+  static constexpr int LEVEL_COUNT = sizeof...(SpeedLevels);
+  static constexpr int SPEED_LEVELS[LEVEL_COUNT] = {SpeedLevels...};
+  static constexpr CommandTable<LEVEL_COUNT> COMMAND_TABLE = buildCommandTable<SpeedLevels...>();
+
+  static_assert(LEVEL_COUNT > 0, "Legalább egy sebesség fokozat kell");
+  static_assert(((SpeedLevels >= 0 && SpeedLevels <= MOTOR_PWM_FULL_SCALE) && ...),
+                "A sebesség fokozatok 0-255 közöttiek legyenek");
+  static_assert(LEVEL_COUNT == sizeof(SPEED_LEVEL_RAMPS_MS) / sizeof(SPEED_LEVEL_RAMPS_MS[0]),
+                "Minden sebesség fokozathoz kell rámpa (SPEED_LEVEL_RAMPS_MS)");
+  static_assert(commandTableConsistent(COMMAND_TABLE, SPEED_LEVELS),
+                "A parancs táblázat eltér a bitek jelentésétől");
+
+  // Kitöltés rámpa (a vezérlési ütem lépteti - updateSlew):
+  // fokozatonkénti gyorsítási lépés (1/256 kitöltés / ütem)
+  static constexpr int32_t riseStep(int level) {
+    return slewStepQ8(SPEED_LEVELS[level], SPEED_LEVEL_RAMPS_MS[level], CONTROL_TICK_HZ);
+  }
+  static constexpr int32_t FALL_STEP = slewStepQ8(MOTOR_PWM_FULL_SCALE, MOTOR_BRAKE_RAMP_MS, CONTROL_TICK_HZ);
+
+  int currentSpeedLevelIndex;
+  SlewLimiter leftSlew;
+  SlewLimiter rightSlew;
+  int leftDuty;                // Kiírt előjeles kitöltés (+ előre, - hátra)
+  int rightDuty;
+  MixerConfig mixerConfig;
+  MotorPwm<PinSet> pwm;        // LEDC vagy MCPWM háttér (motor_pwm.h)
+  PwmUpdateStats pwmStats;     // Csak MOTOR_PWM_MEASURE
+  #if WHEEL_SPEED_CONTROL
+    WheelSpeedControl speedControl;
+    int leftCommand;             // Fordulatszám cél kitöltés skálán (rámpa után)
+    int rightCommand;
+  #endif
+
+  void log(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.println(message);
+    #endif
+  }
+
+public:
+  MotorControl()
+    : currentSpeedLevelIndex(0), leftDuty(0), rightDuty(0), mixerConfig{DRIVE_DEADBAND, DRIVE_EXPO_PERCENT} {}
+
+  bool init() {
+    bool pwmSetupSuccessful = pwm.init();
+    #if WHEEL_SPEED_CONTROL
+      leftCommand = 0;
+      rightCommand = 0;
+      pwmSetupSuccessful &= speedControl.init();
+    #endif
+    
+    if (pwmSetupSuccessful) {
+      log("✅ PWM inicializálás sikeres");
+    }
+    
+    return pwmSetupSuccessful;
+  }
+
+  // Előjeles kitöltés kiírása, csak változáskor (a két oldal egy hívásban)
+  void writeDuty(int left, int right) {
+    if (left == leftDuty && right == rightDuty) {
+      return;
+    }
+    #if MOTOR_PWM_MEASURE
+      uint32_t startCycles = esp_cpu_get_cycle_count();
+      pwm.write(left, right);
+      pwmStats.record(esp_cpu_get_cycle_count() - startCycles);
+    #else
+      pwm.write(left, right);
+    #endif
+    leftDuty = left;
+    rightDuty = right;
+  }
+
+  void dumpPwmStats() const {
+    pwmStats.dump();
+  }
+
+  #if WHEEL_SPEED_CONTROL
+    void dumpSpeedControl() const {
+      speedControl.dump();
+    }
+  #endif
+
+  // Előjeles kerék kitöltés cél (rámpával az updateSlew lépteti,
+  // zárt hurokban a PID fordulatszám célja)
+  void setWheelTargets(int leftTarget, int rightTarget) {
+    #if MOTOR_SLEW_ENABLED
+      leftSlew.setTarget(leftTarget);
+      rightSlew.setTarget(rightTarget);
+    #elif WHEEL_SPEED_CONTROL
+      leftCommand = leftTarget;
+      rightCommand = rightTarget;
+    #else
+      writeDuty(leftTarget, rightTarget);
+    #endif
+  }
+
+  // Vezérlési ütemenként hívandó: a kitöltés egy lépése a cél felé,
+  // zárt hurokban utána a kerék PID (WHEEL_PID_HZ ütemben)
+  void updateSlew() {
+    #if MOTOR_SLEW_ENABLED
+      int32_t rise = riseStep(currentSpeedLevelIndex);
+      int leftStep = leftSlew.step(rise, FALL_STEP);
+      int rightStep = rightSlew.step(rise, FALL_STEP);
+      #if WHEEL_SPEED_CONTROL
+        leftCommand = leftStep;
+        rightCommand = rightStep;
+      #else
+        writeDuty(leftStep, rightStep);
+      #endif
+    #endif
+    #if WHEEL_SPEED_CONTROL
+      if (speedControl.update(leftCommand, rightCommand)) {
+        writeDuty(speedControl.getLeftDuty(), speedControl.getRightDuty());
+      }
+    #endif
+  }
+
+  void stop() {
+    setWheelTargets(0, 0);
+    
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.println("🛑 Motorok leállítva");
+    #endif
+  }
+
+  // Azonnali leállítás rámpa nélkül (failsafe): a fékezési rámpa
+  // (MOTOR_BRAKE_RAMP_MS) nem tolhatja a leállást a FAILSAFE_TIMEOUT_MS után
+  void hardStop() {
+    leftSlew.reset();
+    rightSlew.reset();
+    #if WHEEL_SPEED_CONTROL
+      leftCommand = 0;
+      rightCommand = 0;
+    #endif
+    writeDuty(0, 0);
+    
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.println("🛑 Motorok azonnal leállítva (failsafe)");
+    #endif
+  }
+
+  bool validateCommand(byte command) {
+    if (COMMAND_TABLE.entries[0][command & 0x0F].valid) {
+      return true;
+    }
+    
+    if ((command & 0b0011) == 0b0011) {
+      #if DEBUG_ENABLED && DEBUG_MOTOR
+        debugLog.println("❌ ÉRVÉNYTELEN: Bal motor egyszerre előre és hátra!");
+      #endif
+      return false;
+    }
+    
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.println("❌ ÉRVÉNYTELEN: Jobb motor egyszerre előre és hátra!");
+    #endif
+    return false;
+  }
+
+  // Az egyeztetett (event_channel.h) sebesség váltások végrehajtása
+  void applySpeedEvents(uint8_t events) {
+    if (events == 0) {
+      return;
+    }
+    #if DEBUG_ENABLED && DEBUG_SPEED
+      int previousSpeed = SPEED_LEVELS[currentSpeedLevelIndex];
+    #endif
+    currentSpeedLevelIndex = (currentSpeedLevelIndex + events) % LEVEL_COUNT;
+    
+    #if DEBUG_ENABLED && DEBUG_SPEED
+      debugLog.printf("⚡ Sebesség váltás (%u): %d → %d", events, previousSpeed, SPEED_LEVELS[currentSpeedLevelIndex]);
+    #endif
+  }
+
+  // outputScale: kitöltés szorzó 256-od részekben (failsafe lejtő).
+  // Rámpával csak a célt állítja, a kitöltést az updateSlew lépteti.
+  void executeCommand(byte motorCommand, uint16_t outputScale = 256) {
+    const CommandDuty& duty = COMMAND_TABLE.entries[currentSpeedLevelIndex][motorCommand & 0x0F];
+    if (!duty.valid) {
+      validateCommand(motorCommand);
+      stop();
+      return;
+    }
+    
+    if (motorCommand == 0) {
+      stop();
+    } else if (outputScale == 256) {
+      setWheelTargets(duty.left, duty.right);
+    } else {
+      setWheelTargets(duty.left * outputScale / 256, duty.right * outputScale / 256);
+    }
+  }
+
+  // Arányos vezérlés: kitérített karnál a keverő (drive_mixer.h), a
+  // fokozat sebessége a végállás kitöltése; középállásban a gomb bitmaszk
+  void executeDrive(const DriveInput& drive, uint16_t outputScale = 256) {
+    if (!isDriveDeflected(drive.throttle, drive.steer, mixerConfig)) {
+      executeCommand(drive.motorCommand, outputScale);
+      return;
+    }
+    int maxDuty = (SPEED_LEVELS[currentSpeedLevelIndex] * outputScale) >> 8;
+    WheelDuty duty = mixDrive(drive.throttle, drive.steer, maxDuty, mixerConfig);
+    setWheelTargets(duty.left, duty.right);
+  }
+};
+
+typedef MotorControl<RobotMotorPins, SPEED_LEVEL_1, SPEED_LEVEL_2, SPEED_LEVEL_3> RobotMotorControl;
+
 #endif
\ No newline at end of file
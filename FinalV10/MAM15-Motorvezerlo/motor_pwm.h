@@ -0,0 +1,311 @@
+#ifndef MOTOR_PWM_H
+#define MOTOR_PWM_H
+
+#include <Arduino.h>
+#include "esp_cpu.h"
+#include "settings.h"
+#include "debug_log.h"
+
+#if MOTOR_PWM_MCPWM
+  #include "driver/mcpwm_prelude.h"
+#endif
+
+// ═════════════════════════════════════════════════════════
+// H-HÍD PWM KIMENET (LEDC VAGY MCPWM)
+// ═════════════════════════════════════════════════════════
+// Közös felület: init() és write(bal, jobb) előjeles kitöltéssel
+// (+ előre, - hátra, 0-255 skála mint a SEBESSÉG SZINTEK). A háttér
+// fordítási időben választható (MOTOR_PWM_MCPWM), a lábakat a PinSet
+// típus adja (fordítási idejű konstansok).
+#define MOTOR_PWM_FULL_SCALE 255
+
+// A robot H-híd lábai (settings.h)
+struct RobotMotorPins {
+  static constexpr int LEFT_FORWARD = LEFT_MOTOR_FORWARD_PIN;
+  static constexpr int LEFT_REVERSE = LEFT_MOTOR_REVERSE_PIN;
+  static constexpr int RIGHT_FORWARD = RIGHT_MOTOR_FORWARD_PIN;
+  static constexpr int RIGHT_REVERSE = RIGHT_MOTOR_REVERSE_PIN;
+};
+
+// LEDC: négy független csatorna, egymás után írva (PWM_FREQUENCY, PWM_RESOLUTION)
+template <typename PinSet>
+class LedcBridgePwm {
+private:
+  int leftDuty;
+  int rightDuty;
+
+  static bool attach(int pin, const char* errorMessage) {
+    if (ledcAttach(pin, PWM_FREQUENCY, PWM_RESOLUTION)) {
+      return true;
+    }
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.println(errorMessage);
+    #endif
+    return false;
+  }
+
+public:
+  LedcBridgePwm() : leftDuty(0), rightDuty(0) {}
+
+  bool init() {
+    bool pwmSetupSuccessful = true;
+    pwmSetupSuccessful &= attach(PinSet::LEFT_FORWARD, "❌ Bal motor előre PWM inicializálás sikertelen!");
+    pwmSetupSuccessful &= attach(PinSet::LEFT_REVERSE, "❌ Bal motor hátra PWM inicializálás sikertelen!");
+    pwmSetupSuccessful &= attach(PinSet::RIGHT_FORWARD, "❌ Jobb motor előre PWM inicializálás sikertelen!");
+    pwmSetupSuccessful &= attach(PinSet::RIGHT_REVERSE, "❌ Jobb motor hátra PWM inicializálás sikertelen!");
+    return pwmSetupSuccessful;
+  }
+
+  // Csak a változott oldal csatornái íródnak
+  void write(int left, int right) {
+    if (left != leftDuty) {
+      ledcWrite(PinSet::LEFT_FORWARD, left > 0 ? left : 0);
+      ledcWrite(PinSet::LEFT_REVERSE, left < 0 ? -left : 0);
+      leftDuty = left;
+    }
+    if (right != rightDuty) {
+      ledcWrite(PinSet::RIGHT_FORWARD, right > 0 ? right : 0);
+      ledcWrite(PinSet::RIGHT_REVERSE, right < 0 ? -right : 0);
+      rightDuty = right;
+    }
+  }
+};
+
+#if MOTOR_PWM_MCPWM
+
+static_assert(MCPWM_RESOLUTION_HZ / MCPWM_FREQUENCY >= MOTOR_PWM_FULL_SCALE &&
+              MCPWM_RESOLUTION_HZ / MCPWM_FREQUENCY <= 65535,
+              "MCPWM periódus: legalább 255 lépés (8 bites kitöltés), legfeljebb 16 bit");
+static_assert(MCPWM_DEAD_TIME_NS <= 100000,
+              "A holtidő legfeljebb 100 µs (a write() irányváltáskor ennyit vár)");
+
+// MCPWM: a két H-híd egy közös időzítőn (hídanként egy operátor, kimenetenként
+// egy összehasonlító + generátor). Kimenet: periódus elején magas, az
+// összehasonlításnál alacsony.
+//
+// Frissítés: az összehasonlító és a generátor akció is árnyék regiszterbe
+// íródik, és csak a szoftveres szinkron eseménynél töltődik be. A write() a
+// négy kimenetet előkészíti, majd egyetlen mcpwm_soft_sync_activate() hívással
+// mindkét hidat ugyanazon a periódushatáron váltja (a szinkron a számlálót
+// nullára állítja, az épp futó periódus rövidebb lesz).
+//
+// Holtidő: a hídanként egyetlen holtidő fokozat komplementer párra való, itt a
+// két ág független. Ezért a write() irányváltáskor (ha a rámpa nem nullán át
+// visz, pl. MOTOR_SLEW_ENABLED = false vagy a kerék PID előjelet vált) előbb
+// mindkét ágat nullára kapcsolja, MCPWM_DEAD_TIME_NS-et vár, és csak utána
+// kapcsolja be a másik ágat. A kikapcsolt ág összehasonlítása is 0, így a
+// szinkron után azonnal alacsony (nem a régi összehasonlításig magas).
+template <typename PinSet>
+class McpwmBridgePwm {
+private:
+  static constexpr uint32_t PERIOD_TICKS = MCPWM_RESOLUTION_HZ / MCPWM_FREQUENCY;
+  static constexpr uint32_t DEAD_TIME_US = (MCPWM_DEAD_TIME_NS + 999) / 1000;
+
+  // Kimenetek sorrendje: bal előre, bal hátra, jobb előre, jobb hátra
+  static const int OUTPUT_COUNT = 4;
+
+  mcpwm_timer_handle_t timer;
+  mcpwm_sync_handle_t updateSync;
+  mcpwm_cmpr_handle_t comparators[OUTPUT_COUNT];
+  mcpwm_gen_handle_t generators[OUTPUT_COUNT];
+  bool outputActive[OUTPUT_COUNT];     // Periódus eleji akció: magas (true) / alacsony
+  uint32_t compareTicks[OUTPUT_COUNT];
+  int leftDuty;
+  int rightDuty;
+
+  static bool succeeded(esp_err_t result, const char* errorMessage) {
+    if (result == ESP_OK) {
+      return true;
+    }
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.printf("%s (%d)", errorMessage, (int)result);
+    #endif
+    return false;
+  }
+
+  static mcpwm_gen_timer_event_action_t periodStartAction(bool active) {
+    return MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_EVENT_EMPTY,
+                                        active ? MCPWM_GEN_ACTION_HIGH : MCPWM_GEN_ACTION_LOW);
+  }
+
+  static bool reverses(int previous, int next) {
+    return (previous > 0 && next < 0) || (previous < 0 && next > 0);
+  }
+
+  bool setupOutput(mcpwm_oper_handle_t oper, int pin, int index) {
+    mcpwm_comparator_config_t comparatorConfig = {};
+    comparatorConfig.flags.update_cmp_on_sync = true;
+    if (!succeeded(mcpwm_new_comparator(oper, &comparatorConfig, &comparators[index]),
+                   "❌ MCPWM összehasonlító létrehozása sikertelen!")) {
+      return false;
+    }
+
+    mcpwm_generator_config_t generatorConfig = {};
+    generatorConfig.gen_gpio_num = pin;
+    if (!succeeded(mcpwm_new_generator(oper, &generatorConfig, &generators[index]),
+                   "❌ MCPWM generátor létrehozása sikertelen!")) {
+      return false;
+    }
+
+    return succeeded(mcpwm_generator_set_action_on_timer_event(generators[index], periodStartAction(false)),
+                     "❌ MCPWM periódus akció beállítása sikertelen!") &&
+           succeeded(mcpwm_generator_set_action_on_compare_event(generators[index],
+                       MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP, comparators[index],
+                                                      MCPWM_GEN_ACTION_LOW)),
+                     "❌ MCPWM összehasonlító akció beállítása sikertelen!") &&
+           succeeded(mcpwm_comparator_set_compare_value(comparators[index], 0),
+                     "❌ MCPWM kezdő kitöltés beállítása sikertelen!");
+  }
+
+  bool setupBridge(int forwardPin, int reversePin, int firstIndex) {
+    mcpwm_oper_handle_t oper = nullptr;
+    mcpwm_operator_config_t operatorConfig = {};
+    operatorConfig.group_id = MCPWM_GROUP_ID;
+    operatorConfig.flags.update_gen_action_on_sync = true;
+    return succeeded(mcpwm_new_operator(&operatorConfig, &oper), "❌ MCPWM operátor létrehozása sikertelen!") &&
+           succeeded(mcpwm_operator_connect_timer(oper, timer), "❌ MCPWM operátor csatolása sikertelen!") &&
+           setupOutput(oper, forwardPin, firstIndex) &&
+           setupOutput(oper, reversePin, firstIndex + 1);
+  }
+
+  // Szoftveres szinkron: a számláló nullára áll, az árnyék regiszterek betöltődnek
+  bool setupSync() {
+    mcpwm_soft_sync_config_t syncConfig = {};
+    mcpwm_timer_sync_phase_config_t phaseConfig = {};
+    if (!succeeded(mcpwm_new_soft_sync_src(&syncConfig, &updateSync), "❌ MCPWM szinkron forrás létrehozása sikertelen!")) {
+      return false;
+    }
+    phaseConfig.sync_src = updateSync;
+    phaseConfig.count_value = 0;
+    phaseConfig.direction = MCPWM_TIMER_DIRECTION_UP;
+    return succeeded(mcpwm_timer_set_phase_on_sync(timer, &phaseConfig), "❌ MCPWM szinkron fázis beállítása sikertelen!");
+  }
+
+  // Egy kimenet új értéke az árnyék regiszterekbe (a szinkronig nem hat)
+  bool stageOutput(int index, int duty) {
+    uint32_t ticks = (uint32_t)duty * PERIOD_TICKS / MOTOR_PWM_FULL_SCALE;
+    bool active = ticks > 0;
+    bool changed = false;
+    if (ticks != compareTicks[index]) {
+      mcpwm_comparator_set_compare_value(comparators[index], ticks);
+      compareTicks[index] = ticks;
+      changed = true;
+    }
+    if (active != outputActive[index]) {
+      mcpwm_generator_set_action_on_timer_event(generators[index], periodStartAction(active));
+      outputActive[index] = active;
+      changed = true;
+    }
+    return changed;
+  }
+
+  // Mind a négy kimenet előkészítése, majd egy szinkronnal együtt betöltve
+  void apply(int left, int right) {
+    bool changed = stageOutput(0, left > 0 ? left : 0);
+    changed |= stageOutput(1, left < 0 ? -left : 0);
+    changed |= stageOutput(2, right > 0 ? right : 0);
+    changed |= stageOutput(3, right < 0 ? -right : 0);
+    if (changed) {
+      mcpwm_soft_sync_activate(updateSync);
+    }
+  }
+
+public:
+  McpwmBridgePwm()
+    : timer(nullptr),
+      updateSync(nullptr),
+      comparators{},
+      generators{},
+      outputActive{},
+      compareTicks{},
+      leftDuty(0),
+      rightDuty(0) {}
+
+  bool init() {
+    mcpwm_timer_config_t timerConfig = {};
+    timerConfig.group_id = MCPWM_GROUP_ID;
+    timerConfig.clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT;
+    timerConfig.resolution_hz = MCPWM_RESOLUTION_HZ;
+    timerConfig.count_mode = MCPWM_TIMER_COUNT_MODE_UP;
+    timerConfig.period_ticks = PERIOD_TICKS;
+    bool pwmSetupSuccessful =
+      succeeded(mcpwm_new_timer(&timerConfig, &timer), "❌ MCPWM időzítő létrehozása sikertelen!") &&
+      setupSync() &&
+      setupBridge(PinSet::LEFT_FORWARD, PinSet::LEFT_REVERSE, 0) &&
+      setupBridge(PinSet::RIGHT_FORWARD, PinSet::RIGHT_REVERSE, 2) &&
+      succeeded(mcpwm_timer_enable(timer), "❌ MCPWM időzítő engedélyezése sikertelen!") &&
+      succeeded(mcpwm_timer_start_stop(timer, MCPWM_TIMER_START_NO_STOP), "❌ MCPWM időzítő indítása sikertelen!");
+
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      if (pwmSetupSuccessful) {
+        debugLog.printf("⚙️ MCPWM: %d Hz | periódus: %lu lépés | holtidő irányváltáskor: %lu µs",
+                        MCPWM_FREQUENCY, (unsigned long)PERIOD_TICKS, (unsigned long)DEAD_TIME_US);
+      }
+    #endif
+    return pwmSetupSuccessful;
+  }
+
+  // Irányváltásnál előbb nulla (mindkét ág alacsony), holtidő, utána az új irány
+  void write(int left, int right) {
+    bool leftReverses = reverses(leftDuty, left);
+    bool rightReverses = reverses(rightDuty, right);
+    if (leftReverses || rightReverses) {
+      apply(leftReverses ? 0 : left, rightReverses ? 0 : right);
+      delayMicroseconds(DEAD_TIME_US);
+    }
+    apply(left, right);
+    leftDuty = left;
+    rightDuty = right;
+  }
+};
+
+template <typename PinSet>
+using MotorPwm = McpwmBridgePwm<PinSet>;
+#else
+template <typename PinSet>
+using MotorPwm = LedcBridgePwm<PinSet>;
+#endif
+
+// ═════════════════════════════════════════════════════════
+// KITÖLTÉS FRISSÍTÉS MÉRÉS (MOTOR_PWM_MEASURE)
+// ═════════════════════════════════════════════════════════
+// Egy write() hívás CPU ciklusai (esp_cpu_get_cycle_count). Csak a
+// beavatkozó task írja; a kiírás ('p' parancs) pillanatkép, nem zárol.
+class PwmUpdateStats {
+private:
+  uint32_t updateCount;
+  uint32_t minCycles;
+  uint32_t maxCycles;
+  uint64_t totalCycles;
+
+public:
+  PwmUpdateStats() : updateCount(0), minCycles(UINT32_MAX), maxCycles(0), totalCycles(0) {}
+
+  void record(uint32_t cycles) {
+    updateCount++;
+    totalCycles += cycles;
+    if (cycles < minCycles) {
+      minCycles = cycles;
+    }
+    if (cycles > maxCycles) {
+      maxCycles = cycles;
+    }
+  }
+
+  void dump() const {
+    if (!updateCount) {
+      debugLog.println("⚙️ PWM frissítés - még nincs minta");
+      return;
+    }
+    uint32_t cpuMhz = getCpuFrequencyMhz();
+    uint32_t averageCycles = (uint32_t)(totalCycles / updateCount);
+    debugLog.printf("⚙️ PWM frissítés (%s) - minták: %lu | ciklus min/átlag/max: %lu / %lu / %lu",
+                    MOTOR_PWM_MCPWM ? "MCPWM" : "LEDC", (unsigned long)updateCount,
+                    (unsigned long)minCycles, (unsigned long)averageCycles, (unsigned long)maxCycles);
+    debugLog.printf("⚙️ PWM frissítés - átlag: %lu ns | max: %lu ns (%lu MHz)",
+                    (unsigned long)(averageCycles * 1000 / cpuMhz),
+                    (unsigned long)(maxCycles * 1000 / cpuMhz), (unsigned long)cpuMhz);
+  }
+};
+
+#endif
\ No newline at end of file
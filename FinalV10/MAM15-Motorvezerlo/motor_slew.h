@@ -0,0 +1,70 @@
+#ifndef MOTOR_SLEW_H
+#define MOTOR_SLEW_H
+
+#include <stdint.h>
+
+// ═════════════════════════════════════════════════════════
+// MOTOR KITÖLTÉS MEREDEKSÉG KORLÁTOZÓ (SLEW RATE)
+// ═════════════════════════════════════════════════════════
+// Egy motor előjeles kitöltése (+ előre, - hátra) 1/256 fixpontban. A
+// vezérlési ütem (CONTROL_TICK_HZ) minden lépésben legfeljebb egy lépésnyit
+// mozdít a cél felé:
+//   - gyorsítás (|kitöltés| nő): riseStep
+//   - lassítás / fékezés (|kitöltés| csökken): fallStep
+// Irányváltásnál előbb nulláig fékez, csak utána gyorsít ellenkező irányba,
+// így nincs közvetlen előre → hátra ugrás (áramcsúcs, tapadásvesztés).
+class SlewLimiter {
+private:
+  int32_t currentQ8;
+  int32_t targetQ8;
+
+  static int32_t moveToward(int32_t value, int32_t limit, int32_t step) {
+    if (value < limit) {
+      return value + step < limit ? value + step : limit;
+    }
+    return value - step > limit ? value - step : limit;
+  }
+
+public:
+  SlewLimiter() : currentQ8(0), targetQ8(0) {}
+
+  void setTarget(int duty) {
+    targetQ8 = (int32_t)duty * 256;
+  }
+
+  // Egy ütem. Visszatérés: az aktuális (előjeles) kitöltés
+  int step(int32_t riseStepQ8, int32_t fallStepQ8) {
+    bool towardZero = (currentQ8 > 0 && targetQ8 < currentQ8) || (currentQ8 < 0 && targetQ8 > currentQ8);
+    if (towardZero) {
+      // Ellentétes irányú célnál csak nulláig (fékezés nullán át)
+      bool reversing = (currentQ8 > 0) != (targetQ8 > 0) || targetQ8 == 0;
+      currentQ8 = moveToward(currentQ8, reversing ? 0 : targetQ8, fallStepQ8);
+    } else if (currentQ8 != targetQ8) {
+      currentQ8 = moveToward(currentQ8, targetQ8, riseStepQ8);
+    }
+    return getDuty();
+  }
+
+  // Kerekítés nulla felé (a fixpont maradék nem ad kitöltést)
+  int getDuty() const {
+    return (int)(currentQ8 / 256);
+  }
+
+  bool isSettled() const {
+    return currentQ8 == targetQ8;
+  }
+
+  void reset() {
+    currentQ8 = 0;
+    targetQ8 = 0;
+  }
+};
+
+// Lépésköz (1/256 kitöltés / ütem): fullScaleDuty kitöltést rampMs alatt ér el.
+// 0 ms: azonnali ugrás
+constexpr int32_t slewStepQ8(int fullScaleDuty, int rampMs, int tickHz) {
+  return rampMs > 0 ? ((int32_t)fullScaleDuty * 256 * 1000 + (int32_t)rampMs * tickHz - 1) / ((int32_t)rampMs * tickHz)
+                    : (int32_t)fullScaleDuty * 256;
+}
+
+#endif
\ No newline at end of file
@@ -1,79 +1,174 @@
-#ifndef PACKET_HANDLER_H
-#define PACKET_HANDLER_H
-
-#include <CRC16.h>
-#include "settings.h"
-
-struct PacketData {
-  byte robotId;
-  byte motorCommand;
-  bool speedButtonPressed;
-  bool landingState;
-  uint16_t crc;
-  bool valid;
-};
-
-class PacketHandler {
-private:
-  CRC16 crcCalculator;
-
-  void log(const char* message) {
-    #if DEBUG_ENABLED && DEBUG_CRC
-      Serial.println(message);
-    #endif
-  }
-
-public:
-  PacketHandler() 
-    : crcCalculator(CRC_POLYNOMIAL, CRC_INITIAL_VALUE, CRC_FINAL_XOR_VALUE, true, true) {}
-
-  bool validatePacketSize(int packetSize) {
-    if (packetSize != PACKET_SIZE) {
-      #if DEBUG_ENABLED && DEBUG_LORA
-        Serial.print("⚠️ Hibás csomag méret! Várt: ");
-        Serial.print(PACKET_SIZE);
-        Serial.print(", Kapott: ");
-        Serial.println(packetSize);
-      #endif
-      return false;
-    }
-    return true;
-  }
-
-  PacketData parsePacket(byte* receivedPacket) {
-    PacketData data;
-    data.valid = false;
-    
-    // CRC ellenőrzés
-    uint16_t receivedCRC = (receivedPacket[4] << 8) | receivedPacket[5];
-    crcCalculator.restart();
-    crcCalculator.add(receivedPacket, 4);
-    uint16_t calculatedCRC = crcCalculator.getCRC();
-    
-    if (receivedCRC != calculatedCRC) {
-      log("❌ Hibás CRC - csomag elvetve!");
-      return data;
-    }
-    
-    // Robot ID ellenőrzés
-    if (receivedPacket[0] != ROBOT_ID) {
-      #if DEBUG_ENABLED && DEBUG_LORA
-        Serial.print("⚠️ Csomag másik robotnak: ");
-        Serial.println(receivedPacket[0]);
-      #endif
-      return data;
-    }
-    
-    // Adatok kinyerése
-    data.robotId = receivedPacket[0];
-    data.motorCommand = receivedPacket[1];
-    data.speedButtonPressed = receivedPacket[2];
-    data.landingState = receivedPacket[3];
-    data.crc = receivedCRC;
-    data.valid = true;
-    
-    return data;
-  }
-};
-
+#ifndef PACKET_HANDLER_H
+#define PACKET_HANDLER_H
+
+#include "crc16_ccitt.h"
+#include "packet_v2.h"
+#include "packet_fec.h"
+#include "settings.h"
+#include "debug_log.h"
+
+static_assert(!LATENCY_INSTRUMENTATION || PACKET_FORMAT == PACKET_FORMAT_V1,
+              "A késleltetés mérés időbélyege csak a v1 csomagban fér el");
+static_assert(!PACKET_FEC || PACKET_FORMAT == PACKET_FORMAT_V1,
+              "A hibajavítás (PACKET_FEC) csak a v1 csomaggal használható");
+static_assert(!DRIVE_MODE_PROPORTIONAL || PACKET_FORMAT == PACKET_FORMAT_V1,
+              "Az arányos vezérlés (gáz/kormány) csak a v1 csomagban fér el");
+
+typedef Crc16Engine<CRC_POLYNOMIAL, CRC_INITIAL_VALUE, CRC_FINAL_XOR_VALUE, CRC_SLICE_BY_4> PacketCRC;
+
+// Az elvetés oka (link statisztikához)
+enum PacketStatus {
+  PACKET_OK,
+  PACKET_CRC_ERROR,
+  PACKET_FOREIGN_ROBOT,
+  PACKET_FEC_ERROR,            // Javíthatatlan bithiba (PACKET_FEC)
+  PACKET_CONTROL               // v2 vezérlő keret (ADR kikapcsolva nem feldolgozott)
+};
+
+struct PacketData {
+  byte robotId;
+  byte motorCommand;
+  uint8_t speedEventCount;     // Sebesség váltás számláló (körbeforduló, event_channel.h)
+  uint8_t speedEventMask;      // Számláló szélesség: v1 8 bit, v2 3 bit
+  uint8_t speedEvents;         // Egyeztetés után végrehajtandó váltások (rádió task tölti)
+  bool landingState;
+  uint8_t copyIndex;           // Ismétlés példány sorszáma (0 = első)
+  uint8_t sequence;            // Távirányító csomag sorszám (körbeforduló)
+  uint16_t remoteStamp;        // Gomb mintavétel ideje (csak LATENCY_INSTRUMENTATION)
+  int8_t throttle;             // Arányos gáz / kormány (csak DRIVE_MODE_PROPORTIONAL, különben 0)
+  int8_t steer;
+  int64_t rxTimeUs;            // Vétel ideje a robot óráján
+  uint16_t crc;
+  bool fecCorrected;           // A hibajavítás legalább egy bitet javított
+  bool valid;
+  PacketStatus status;
+};
+
+class PacketHandler {
+private:
+  void log(const char* message) {
+    #if DEBUG_ENABLED && DEBUG_CRC
+      debugLog.println(message);
+    #endif
+  }
+
+public:
+  bool validatePacketSize(int packetSize) {
+    bool v1Accepted = PACKET_FORMAT != PACKET_FORMAT_V2 && packetSize == PACKET_V1_AIR_SIZE;
+    bool v2Accepted = PACKET_FORMAT != PACKET_FORMAT_V1 && packetSize == PACKET_V2_SIZE;
+    if (!v1Accepted && !v2Accepted) {
+      #if DEBUG_ENABLED && DEBUG_LORA
+        debugLog.printf("⚠️ Hibás csomag méret! Várt: %d, Kapott: %d", LORA_FRAME_SIZE, packetSize);
+      #endif
+      return false;
+    }
+    return true;
+  }
+
+  // A formátumot a (már ellenőrzött) méret dönti el
+  PacketData parsePacket(byte* receivedPacket, int packetSize) {
+    PacketData data;
+    data.valid = false;
+    data.status = PACKET_CRC_ERROR;
+    data.fecCorrected = false;
+
+    if (packetSize == PACKET_V2_SIZE) {
+      return parsePacketV2(receivedPacket, data);
+    }
+    
+    // Hibajavítás a CRC ellenőrzés előtt (a javított keret helyi pufferbe kerül)
+    #if PACKET_FEC
+      byte decodedPacket[PACKET_SIZE];
+      int correctedCodewords;
+      FecStatus fecStatus = PacketFec::decode(receivedPacket, PACKET_SIZE, decodedPacket, correctedCodewords);
+      if (fecStatus == FEC_UNCORRECTABLE) {
+        log("❌ Javíthatatlan bithiba (FEC) - csomag elvetve!");
+        data.status = PACKET_FEC_ERROR;
+        return data;
+      }
+      data.fecCorrected = fecStatus == FEC_CORRECTED;
+      receivedPacket = decodedPacket;
+    #endif
+    
+    // CRC ellenőrzés
+    uint16_t receivedCRC = (receivedPacket[PACKET_PAYLOAD_SIZE] << 8) | receivedPacket[PACKET_PAYLOAD_SIZE + 1];
+    uint16_t calculatedCRC = PacketCRC::compute(receivedPacket, PACKET_PAYLOAD_SIZE);
+    
+    if (receivedCRC != calculatedCRC) {
+      log("❌ Hibás CRC - csomag elvetve!");
+      return data;
+    }
+    
+    // Robot ID ellenőrzés
+    if (receivedPacket[0] != ROBOT_ID) {
+      #if DEBUG_ENABLED && DEBUG_LORA
+        debugLog.printf("⚠️ Csomag másik robotnak: %u", receivedPacket[0]);
+      #endif
+      data.status = PACKET_FOREIGN_ROBOT;
+      return data;
+    }
+    
+    // Adatok kinyerése
+    data.robotId = receivedPacket[0];
+    data.motorCommand = receivedPacket[1];
+    data.speedEventCount = receivedPacket[2];
+    data.speedEventMask = 0xFF;
+    data.speedEvents = 0;
+    data.landingState = receivedPacket[3] & 0x01;
+    data.copyIndex = (receivedPacket[3] >> 1) & 0x03;
+    data.sequence = receivedPacket[4];
+    #if LATENCY_INSTRUMENTATION
+      data.remoteStamp = (receivedPacket[5] << 8) | receivedPacket[6];
+    #else
+      data.remoteStamp = 0;
+    #endif
+    #if DRIVE_MODE_PROPORTIONAL
+      data.throttle = (int8_t)receivedPacket[PACKET_DRIVE_OFFSET];
+      data.steer = (int8_t)receivedPacket[PACKET_DRIVE_OFFSET + 1];
+    #else
+      data.throttle = 0;
+      data.steer = 0;
+    #endif
+    data.rxTimeUs = 0;
+    data.crc = receivedCRC;
+    data.valid = true;
+    data.status = PACKET_OK;
+    
+    return data;
+  }
+
+private:
+  // A robot ID a CRC kezdőértékében van: idegen csomag CRC hibaként jelenik meg
+  PacketData& parsePacketV2(const byte* receivedPacket, PacketData& data) {
+    PacketV2 packet;
+    PacketV2Status status = decodePacketV2(receivedPacket, ROBOT_ID, packet);
+    if (status != PACKET_V2_OK) {
+      log(status == PACKET_V2_BAD_VERSION ? "❌ Ismeretlen csomag verzió - csomag elvetve!"
+                                          : "❌ Hibás CRC (v2) - csomag elvetve!");
+      return data;
+    }
+    if (packet.command == PACKET_V2_CONTROL_COMMAND) {
+      data.status = PACKET_CONTROL;
+      return data;
+    }
+
+    data.robotId = ROBOT_ID;
+    data.motorCommand = packet.command;
+    data.speedEventCount = packet.speedEventCount;
+    data.speedEventMask = PACKET_V2_EVENT_MASK;
+    data.speedEvents = 0;
+    data.landingState = packet.landingFlag;
+    data.copyIndex = packet.copyIndex;
+    data.sequence = packet.sequence;
+    data.remoteStamp = 0;
+    data.throttle = 0;
+    data.steer = 0;
+    data.rxTimeUs = 0;
+    data.crc = receivedPacket[PACKET_V2_SIZE - 1];
+    data.valid = true;
+    data.status = PACKET_OK;
+    return data;
+  }
+};
+
 #endif
\ No newline at end of file
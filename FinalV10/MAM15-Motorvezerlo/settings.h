@@ -1,96 +1,266 @@
-#ifndef SETTINGS_H
-#define SETTINGS_H
-
-// ═════════════════════════════════════════════════════════
-// DEBUG BEÁLLÍTÁSOK - KOMPONENSENKÉNT
-// ═════════════════════════════════════════════════════════
-#define DEBUG_ENABLED true         // Fő debug kapcsoló
-
-#define DEBUG_LORA true            // LoRa kommunikáció logolása
-#define DEBUG_MOTOR true           // Motor műveletek logolása
-#define DEBUG_ESPNOW true          // ESP-NOW kommunikáció logolása
-#define DEBUG_CRC true             // CRC ellenőrzés logolása
-#define DEBUG_LANDING true         // Landoló parancsok logolása
-#define DEBUG_SPEED true           // Sebesség váltás logolása
-#define DEBUG_FAILSAFE true        // Failsafe események logolása
-#define DEBUG_HEALTH true          // Health check logolása
-#define DEBUG_LED_FLASH true       // LED Flash toggle logolása
-
-// ═════════════════════════════════════════════════════════
-// ROBOT AZONOSÍTÓ
-// ═════════════════════════════════════════════════════════
-#define ROBOT_ID 69
-
-// ═════════════════════════════════════════════════════════
-// LORA KOMMUNIKÁCIÓS BEÁLLÍTÁSOK
-// ═════════════════════════════════════════════════════════
-#define LORA_SCK_PIN 18
-#define LORA_MISO_PIN 19
-#define LORA_MOSI_PIN 23
-#define LORA_SS_PIN 5
-#define LORA_RESET_PIN 14
-#define LORA_DIO0_PIN 2
-#define LORA_FREQUENCY 433E6
-
-// ═════════════════════════════════════════════════════════
-// LORA HEALTH MONITOR BEÁLLÍTÁSOK
-// ═════════════════════════════════════════════════════════
-#define LORA_HEALTH_CHECK_INTERVAL 5000     // Health check időköz (ms)
-#define LORA_RECONNECT_TIMEOUT 10000        // Újracsatlakozási timeout (ms)
-#define MAX_LORA_RESTARTS 3                 // Max újraindítási kísérletek
-
-// ═════════════════════════════════════════════════════════
-// ESP-NOW BEÁLLÍTÁSOK - LANDOLÓ MAC CÍME (1C:DB:D4:D5:D0:28)
-// ═════════════════════════════════════════════════════════
-#define LANDOLO_MAC_0 0x1C
-#define LANDOLO_MAC_1 0xDB
-#define LANDOLO_MAC_2 0xD4
-#define LANDOLO_MAC_3 0xD5
-#define LANDOLO_MAC_4 0xD0
-#define LANDOLO_MAC_5 0x28
-
-// ═════════════════════════════════════════════════════════
-// LED FLASH BEÁLLÍTÁSOK (Landoló gomb második funkciója)
-// ═════════════════════════════════════════════════════════
-#define LED_FLASH_PIN 22           // Toggle kimenet pin
-
-// ═════════════════════════════════════════════════════════
-// CRC ELLENŐRZÉS BEÁLLÍTÁSAI
-// ═════════════════════════════════════════════════════════
-#define CRC_POLYNOMIAL 0x1021
-#define CRC_INITIAL_VALUE 0xFFFF
-#define CRC_FINAL_XOR_VALUE 0x0000
-
-// ═════════════════════════════════════════════════════════
-// MOTOR VEZÉRLŐ PIN DEFINÍCIÓK
-// ═════════════════════════════════════════════════════════
-#define LEFT_MOTOR_FORWARD_PIN 32
-#define LEFT_MOTOR_REVERSE_PIN 27
-#define RIGHT_MOTOR_FORWARD_PIN 25
-#define RIGHT_MOTOR_REVERSE_PIN 26
-
-// ═════════════════════════════════════════════════════════
-// PWM BEÁLLÍTÁSOK
-// ═════════════════════════════════════════════════════════
-#define PWM_FREQUENCY 50
-#define PWM_RESOLUTION 8
-
-// ═════════════════════════════════════════════════════════
-// SEBESSÉG SZINTEK (0-255)
-// ═════════════════════════════════════════════════════════
-#define SPEED_LEVEL_1 255          // Maximális sebesség
-#define SPEED_LEVEL_2 120          // Közepes sebesség
-#define SPEED_LEVEL_3 40           // Lassú sebesség
-
-// ═════════════════════════════════════════════════════════
-// BIZTONSÁGI BEÁLLÍTÁSOK (FAILSAFE)
-// ═════════════════════════════════════════════════════════
-#define FAILSAFE_TIMEOUT_MS 300    // Failsafe timeout (ms)
-
-// ═════════════════════════════════════════════════════════
-// EGYÉB BEÁLLÍTÁSOK
-// ═════════════════════════════════════════════════════════
-#define SERIAL_BAUD_RATE 115200
-#define PACKET_SIZE 6              // LoRa csomag mérete
-
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+// ═════════════════════════════════════════════════════════
+// DEBUG BEÁLLÍTÁSOK - KOMPONENSENKÉNT
+// ═════════════════════════════════════════════════════════
+#define DEBUG_ENABLED true         // Fő debug kapcsoló
+
+#define DEBUG_LORA true            // LoRa kommunikáció logolása
+#define DEBUG_MOTOR true           // Motor műveletek logolása
+#define DEBUG_ESPNOW true          // ESP-NOW kommunikáció logolása
+#define DEBUG_CRC true             // CRC ellenőrzés logolása
+#define DEBUG_LANDING true         // Landoló parancsok logolása
+#define DEBUG_SPEED true           // Sebesség váltás logolása
+#define DEBUG_FAILSAFE true        // Failsafe események logolása
+#define DEBUG_HEALTH true          // Health check logolása
+#define DEBUG_LED_FLASH true       // LED Flash toggle logolása
+#define DEBUG_PIPELINE true        // Pipeline statisztikák logolása
+#define DEBUG_TIMING true          // Vezérlési ütem időzítés logolása
+#define DEBUG_LATENCY true         // Gomb→PWM késleltetés logolása
+#define DEBUG_LINK true            // Link minőség ablakonkénti logolása
+
+// ═════════════════════════════════════════════════════════
+// NEM BLOKKOLÓ LOG PUFFER (debug_log.h)
+// ═════════════════════════════════════════════════════════
+#define LOG_RING_LINES 32          // Pufferelt sorok száma
+#define LOG_LINE_LENGTH 128        // Egy sor max. hossza (byte, UTF-8)
+#define LOG_DRAIN_INTERVAL_MS 10   // Kiíró task ébredési időköze (ms)
+#define LOG_DRAIN_TASK_PRIORITY 1  // Kiíró task prioritása (alacsony)
+#define LOG_DRAIN_TASK_STACK 3072  // Kiíró task stack mérete (byte)
+
+// ═════════════════════════════════════════════════════════
+// ROBOT AZONOSÍTÓ
+// ═════════════════════════════════════════════════════════
+#define ROBOT_ID 69
+
+// ═════════════════════════════════════════════════════════
+// LORA KOMMUNIKÁCIÓS BEÁLLÍTÁSOK
+// ═════════════════════════════════════════════════════════
+#define LORA_SCK_PIN 18
+#define LORA_MISO_PIN 19
+#define LORA_MOSI_PIN 23
+#define LORA_SS_PIN 5
+#define LORA_RESET_PIN 14
+#define LORA_DIO0_PIN 2
+#define LORA_FREQUENCY 433E6
+#define LORA_PHY_PROFILE LORA_PROFILE_BALANCED  // lora_phy_profile.h - egyezzen a távirányítóval!
+#define REMOTE_KEEPALIVE_INTERVAL_MS 100    // A távirányító életjel periódusa - egyezzen!
+#define REMOTE_REPEAT_MAX_GAP_MS 12         // Ismétlések közti leghosszabb szünet (RepeatSettings maxGapMs) - egyezzen!
+#define REMOTE_REPEAT_COPIES_LOWEST_LATENCY 2  // Ismétlések profilonként (RepeatSettings copies) - egyezzen!
+#define REMOTE_REPEAT_COPIES_BALANCED 1
+#define REMOTE_REPEAT_COPIES_LONG_RANGE 0
+#define LORA_SYNC_WORD_PER_ROBOT true       // Szinkron szó ROBOT_ID-ből (lora_sync_word.h) - egyezzen!
+
+// ═════════════════════════════════════════════════════════
+// LORA HEALTH MONITOR BEÁLLÍTÁSOK
+// ═════════════════════════════════════════════════════════
+#define LORA_HEALTH_CHECK_INTERVAL 5000     // Health check időköz (ms)
+#define LORA_RECONNECT_TIMEOUT 10000        // Újracsatlakozási timeout / új sorozat előtti szünet (ms)
+#define MAX_LORA_RESTARTS 3                 // Max. újraindítási kísérlet egy sorozatban
+#define LORA_RESTART_BACKOFF_MS 1000        // Várakozás sikertelen kísérlet után (ms)
+#define LORA_SHUTDOWN_SETTLE_MS 100         // LoRa.end() utáni várakozás (ms)
+#define LORA_RESET_PULSE_MS 10              // RESET impulzus hossza (ms)
+#define LORA_RESET_SETTLE_MS 50             // RESET utáni felfutási idő (ms)
+#define LORA_RECOVERY_POLL_MS 5             // Lépésköz újraindítás közben (ms)
+
+// ═════════════════════════════════════════════════════════
+// LORA VÉTELI MÓD (DIO0 MEGSZAKÍTÁS + FREERTOS QUEUE)
+// ═════════════════════════════════════════════════════════
+#define LORA_RX_INTERRUPT_MODE true         // true = DIO0 megszakítás, false = polling
+#define LORA_RX_QUEUE_LENGTH 4              // Várakozó csomagok max. száma
+#define LORA_RX_TASK_PRIORITY 5             // Vételi task prioritása
+#define LORA_RX_TASK_STACK 4096             // Vételi task stack mérete (byte)
+#define LORA_RX_TASK_CORE 0                 // Vételi task magja
+#define LORA_RX_WAIT_MS 20                  // Max. várakozás csomagra a rádió taskban (ms)
+#define LORA_BURST_FIFO_READ true           // true = FIFO egy SPI burst-tel, false = bájtonkénti LoRa.read()
+#define LORA_NATIVE_DRIVER false            // true = saját SX127x meghajtó (sx127x.h) a LoRa könyvtár helyett
+
+// ═════════════════════════════════════════════════════════
+// ADAPTÍV ADATSEBESSÉG (ADR, link_adr.h + adr_controller.h)
+// ═════════════════════════════════════════════════════════
+// Alapból kikapcsolva. A lépcső csak a légidő ellenőrzésen (loraPhyProfileFits) átmenő
+// profilokat tartalmazza: 100 ms életjel / 300 ms failsafe mellett a nagy hatótáv
+// profil (SF10, ~300 ms légidő) nem fér bele, így a váltás legkisebb késés ↔
+// kiegyensúlyozott között történik (adr_controller.h: ADR_MOST_ROBUST_PROFILE)
+#define ADR_ENABLED false                   // SNR alapú automatikus PHY profil váltás
+#define ADR_WINDOW_MS 2000                  // SNR tartalék mérési ablak (ms)
+#define ADR_MIN_WINDOW_PACKETS 5            // Ennél kevesebb csomagból nem dönt
+#define ADR_DOWN_MARGIN_DB 3.0f             // Ez alatti tartaléknál robusztusabb profilra vált
+#define ADR_UP_MARGIN_DB 10.0f              // A gyorsabb profil becsült tartaléka legalább ennyi
+#define ADR_UP_WINDOWS 2                    // Ennyi egymás utáni jó ablak kell a gyorsításhoz
+#define ADR_HOLDOFF_WINDOWS 2               // Váltás / sikertelen kérés után kihagyott ablakok
+#define ADR_REQUEST_RETRIES 3               // Kérés ismétlések száma
+#define ADR_REQUEST_RETRY_MS 150            // Kérések közötti min. idő (ms)
+#define ADR_CONFIRM_TIMEOUT_MS 600          // Váltás megerősítési ideje (egyezzen a távirányítóval!)
+#define ADR_BEACON_INTERVAL_MS 250          // Megerősítő / életjel keret időköze nem alap profilon (ms)
+#define ADR_LINK_LOST_MS 1500               // Csomag nélkül ennyi után vissza az alap profilra (egyezzen!)
+#define ADR_LOG_SIZE 8                      // Megőrzött profilváltások száma
+
+// ═════════════════════════════════════════════════════════
+// TDMA MÓD (tdma_schedule.h + tdma_receiver.h)
+// ═════════════════════════════════════════════════════════
+// Egy koordinátor több robotot hajt időrésekben - a beállítások
+// egyezzenek a távirányító TdmaSettings értékeivel!
+#define TDMA_ENABLED false                  // true = csak a saját időrésben vesz
+#define TDMA_SLOT_COUNT 2                   // Időrések száma a szuperkeretben
+#define TDMA_SLOT_INDEX 0                   // Ennek a robotnak az időrése (0..TDMA_SLOT_COUNT-1)
+#define TDMA_GUARD_US 3000                  // Védőidő időrésenként (µs)
+#define TDMA_RX_LEAD_US 2000                // Vevő bekapcsolása ennyivel az időrés előtt (µs)
+#define TDMA_SYNC_LOST_SUPERFRAMES 3        // Ennyi kihagyott saját rés után folyamatos vétel
+
+// ═════════════════════════════════════════════════════════
+// KÉTMAGOS PIPELINE (RÁDIÓ TASK → GYŰRŰ → BEAVATKOZÓ TASK)
+// ═════════════════════════════════════════════════════════
+#define PIPELINE_RING_SIZE 8                // PacketData gyűrű mérete (2 hatványa)
+#define PIPELINE_STATS_INTERVAL_MS 5000     // Statisztika kiírás időköze (ms)
+#define RADIO_TASK_CORE 0                   // Rádió task magja (WiFi/ESP-NOW is itt fut)
+#define RADIO_TASK_PRIORITY 3
+#define RADIO_TASK_STACK 4096
+#define ACTUATION_TASK_CORE 1               // Beavatkozó (PWM) task magja
+#define ACTUATION_TASK_PRIORITY 4
+#define ACTUATION_TASK_STACK 4096
+
+// ═════════════════════════════════════════════════════════
+// VEZÉRLÉSI ÜTEM (esp_timer) - beavatkozás + failsafe kiértékelés
+// ═════════════════════════════════════════════════════════
+#define CONTROL_TICK_HZ 200                 // Vezérlési frekvencia (Hz)
+
+// ═════════════════════════════════════════════════════════
+// ESP-NOW BEÁLLÍTÁSOK - LANDOLÓ MAC CÍME (1C:DB:D4:D5:D0:28)
+// ═════════════════════════════════════════════════════════
+#define LANDOLO_MAC_0 0x1C
+#define LANDOLO_MAC_1 0xDB
+#define LANDOLO_MAC_2 0xD4
+#define LANDOLO_MAC_3 0xD5
+#define LANDOLO_MAC_4 0xD0
+#define LANDOLO_MAC_5 0x28
+
+// ═════════════════════════════════════════════════════════
+// LED FLASH BEÁLLÍTÁSOK (Landoló gomb második funkciója)
+// ═════════════════════════════════════════════════════════
+#define LED_FLASH_PIN 22           // Toggle kimenet pin
+
+// ═════════════════════════════════════════════════════════
+// CRC ELLENŐRZÉS BEÁLLÍTÁSAI
+// ═════════════════════════════════════════════════════════
+#define CRC_POLYNOMIAL 0x1021
+#define CRC_INITIAL_VALUE 0xFFFF
+#define CRC_FINAL_XOR_VALUE 0x0000
+#define CRC_SLICE_BY_4 false       // true = 4 bájtos slice-by-4 (4x nagyobb táblázat)
+
+// ═════════════════════════════════════════════════════════
+// MOTOR VEZÉRLŐ PIN DEFINÍCIÓK
+// ═════════════════════════════════════════════════════════
+#define LEFT_MOTOR_FORWARD_PIN 32
+#define LEFT_MOTOR_REVERSE_PIN 27
+#define RIGHT_MOTOR_FORWARD_PIN 25
+#define RIGHT_MOTOR_REVERSE_PIN 26
+
+// ═════════════════════════════════════════════════════════
+// PWM BEÁLLÍTÁSOK
+// ═════════════════════════════════════════════════════════
+#define PWM_FREQUENCY 50
+#define PWM_RESOLUTION 8
+
+// MCPWM háttér (motor_pwm.h): a két H-híd egy időzítőn, egy szinkronnal egyszerre vált
+#define MOTOR_PWM_MCPWM false         // true = MCPWM, false = LEDC (PWM_FREQUENCY, PWM_RESOLUTION)
+#define MCPWM_GROUP_ID 0
+#define MCPWM_RESOLUTION_HZ 10000000  // Időzítő órajel (Hz): 100 ns lépés
+#define MCPWM_FREQUENCY 20000         // PWM frekvencia (Hz): hallható tartomány felett, 500 lépés
+#define MCPWM_DEAD_TIME_NS 500        // Holtidő irányváltáskor: mindkét ág alacsony (µs-re kerekítve)
+#define MOTOR_PWM_MEASURE false       // true = kitöltés frissítés CPU ciklus mérése ('p' parancs)
+
+// ═════════════════════════════════════════════════════════
+// SEBESSÉG SZINTEK (0-255)
+// ═════════════════════════════════════════════════════════
+#define SPEED_LEVEL_1 255          // Maximális sebesség
+#define SPEED_LEVEL_2 120          // Közepes sebesség
+#define SPEED_LEVEL_3 40           // Lassú sebesség
+
+// Gyorsítási rámpa (motor_slew.h) fokozatonként: 0 → a fokozat kitöltése ennyi idő alatt (ms)
+// Fékezés / lassítás: a teljes (255) kitöltésről nullára MOTOR_BRAKE_RAMP_MS alatt
+// (a failsafe leállás nem rámpázik: FAILSAFE_TIMEOUT_MS-nél azonnal 0 kitöltés)
+#define MOTOR_SLEW_ENABLED true    // false = azonnali kitöltés ugrás (régi viselkedés)
+#define SPEED_LEVEL_1_RAMP_MS 400
+#define SPEED_LEVEL_2_RAMP_MS 250
+#define SPEED_LEVEL_3_RAMP_MS 100
+#define MOTOR_BRAKE_RAMP_MS 150
+
+// Zárt hurkú kerék szabályozás (wheel_speed_control.h): a rámpa utáni kitöltés
+// fordulatszám cél lesz, kerekenként PID a PCNT enkóder alapján
+#define WHEEL_SPEED_CONTROL false      // false = nyílt hurkú kitöltés (régi viselkedés)
+#define LEFT_ENCODER_A_PIN 34
+#define LEFT_ENCODER_B_PIN 35          // -1 = egycsatornás enkóder
+#define RIGHT_ENCODER_A_PIN 36
+#define RIGHT_ENCODER_B_PIN 39
+#define ENCODER_GLITCH_FILTER_NS 1000  // Ennél rövidebb impulzus zaj (PCNT szűrő)
+#define WHEEL_MAX_SPEED_CPS 2000       // ±255 parancs célja (imp/s) - a szabadon futó
+                                       // sebesség kb. 80%-a, hogy merülő akkun is legyen tartalék
+#define WHEEL_PID_HZ 50                // PID ütem (a CONTROL_TICK_HZ osztója)
+#define WHEEL_PID_KP 0.10f             // Kitöltés / (imp/s)
+#define WHEEL_PID_KI 0.6f              // Kitöltés / imp
+#define WHEEL_PID_KD 0.0f
+#define WHEEL_PID_INTEGRAL_LIMIT 120.0f  // Integrátor korlát (kitöltés)
+
+// Arányos vezérlés (drive_mixer.h): gáz/kormány a v1 csomagban - a távirányítóval egyezzen!
+// A kar középállásában a gomb bitmaszk vezérel (tartalék mód)
+#define DRIVE_MODE_PROPORTIONAL false
+#define DRIVE_DEADBAND 6           // Holtsáv a ±127 skálán
+#define DRIVE_EXPO_PERCENT 30      // 0 = lineáris, 100 = tisztán köbös
+
+// A sebesség váltás számláló (event_channel.h) és a sorszám ablak (link_stats.h) ennyi
+// csend után új alapértéket vesz fel (a távirányító közben újraindulhatott); rövidebb
+// kiesés váltásai pótlódnak
+#define SPEED_EVENT_RESYNC_MS 2000
+
+// ═════════════════════════════════════════════════════════
+// BIZTONSÁGI BEÁLLÍTÁSOK (FAILSAFE)
+// ═════════════════════════════════════════════════════════
+#define FAILSAFE_TIMEOUT_MS 300    // Failsafe timeout (ms) - eddig biztosan leáll
+// Kétlépcsős failsafe (failsafe.h): tartás a mért csomagköz alapján, majd lejtő.
+// A tartás legalább az életjelek közti csomagköz (életjel + ismétlés szünet + légidő)
+#define FAILSAFE_HOLD_INTERVALS 2  // Tartás: ennyi mért csomagköz
+#define FAILSAFE_HOLD_MIN_MS 60    // Tartás alsó korlátja (ms), ha az életjel köz ennél rövidebb
+#define FAILSAFE_RAMP_MS 100       // Lejtő hossza (ms) - a tartás legfeljebb TIMEOUT - RAMP
+
+// ═════════════════════════════════════════════════════════
+// LINK MINŐSÉG STATISZTIKA (link_stats.h)
+// ═════════════════════════════════════════════════════════
+#define LINK_STATS_WINDOW_MS 5000          // Statisztikai ablak hossza (ms)
+// A távirányító ismétlései (RepeatSettings: legfeljebb 2 × 8 ms / 1 × 12 ms köz) ennyin
+// belül érkeznek. Ezen túl egy már látott sorszám első példánya (copyIndex 0) nem
+// ismétlés, hanem újraindult távirányító: a sorszám ablak új alapértéket vesz fel
+#define LINK_REPEAT_WINDOW_MS 50
+
+// ═════════════════════════════════════════════════════════
+// GOMB → PWM KÉSLELTETÉS MÉRÉS (MŰSZEREZETT BUILD)
+// ═════════════════════════════════════════════════════════
+#define LATENCY_INSTRUMENTATION false      // true = időbélyeg a csomagban (a távirányítón is!)
+#define LATENCY_STAMP_UNIT_US 100          // Időbélyeg felbontása (µs) - egyezzen a távirányítóval
+#define LATENCY_OFFSET_WINDOW 64           // Óra eltolás becslés ablaka (csomag)
+#define LATENCY_HIST_BUCKET_US 500         // Hisztogram felbontás (µs)
+#define LATENCY_HIST_BUCKETS 200           // 200 x 0.5 ms = 100 ms + túlcsordulás
+#define LATENCY_PROFILE_SLOTS LORA_PROFILE_COUNT  // Hisztogram PHY profilonként (lora_phy_profile.h)
+
+// ═════════════════════════════════════════════════════════
+// EGYÉB BEÁLLÍTÁSOK
+// ═════════════════════════════════════════════════════════
+#define SERIAL_BAUD_RATE 115200
+#define PACKET_DRIVE_OFFSET (LATENCY_INSTRUMENTATION ? 7 : 5)  // ID + parancs + sebesség számláló + landoló/példány + sorszám (+ időbélyeg)
+#define PACKET_PAYLOAD_SIZE (PACKET_DRIVE_OFFSET + (DRIVE_MODE_PROPORTIONAL ? 2 : 0))  // (+ gáz + kormány)
+#define PACKET_SIZE (PACKET_PAYLOAD_SIZE + 2)                 // LoRa csomag mérete (+ CRC16)
+
+// Csomag formátum (packet_v2.h) - a távirányítóval összehangolva!
+//   PACKET_FORMAT_V1      - csak v1 (explicit fejléc)
+//   PACKET_FORMAT_ROLLOUT - v1 és v2 is elfogadva (explicit fejléc)
+//   PACKET_FORMAT_V2      - csak 4 bájtos v2 (implicit fejléc)
+#define PACKET_FORMAT PACKET_FORMAT_V1
+// Hibajavítás (packet_fec.h): Hamming(8,4) a teljes v1 kereten, dupla méret - egyezzen!
+// BALANCED profilon a légidő 31 → 41 ms; kb. 0.5% bithibaarány felett ad több átjutó parancsot
+#define PACKET_FEC false
+#define PACKET_V1_AIR_SIZE (PACKET_FEC ? fecEncodedSize(PACKET_SIZE) : PACKET_SIZE)  // Adott v1 keret
+#define LORA_FRAME_SIZE packetFrameSize(PACKET_FORMAT, PACKET_V1_AIR_SIZE)       // Légidő számításhoz
+#define LORA_IMPLICIT_HEADER packetImplicitHeader(PACKET_FORMAT)
+
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ═════════════════════════════════════════════════════════
+// LOCK-FREE SPSC GYŰRŰPUFFER
+// ═════════════════════════════════════════════════════════
+// Egy író (rádió task) és egy olvasó (beavatkozó task) között,
+// zárolás nélkül. Az indexek szabadon futnak, a kapacitás 2 hatványa.
+template <typename T, uint32_t Capacity>
+class SpscRing {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscRing: a kapacitásnak 2 hatványának kell lennie");
+
+private:
+  T buffer[Capacity];
+  std::atomic<uint32_t> head;        // Következő írási pozíció (író)
+  std::atomic<uint32_t> tail;        // Következő olvasási pozíció (olvasó)
+  std::atomic<uint32_t> pushedCount;
+  std::atomic<uint32_t> overflowCount;
+  std::atomic<uint32_t> highWatermark;
+
+public:
+  SpscRing()
+    : head(0)
+    , tail(0)
+    , pushedCount(0)
+    , overflowCount(0)
+    , highWatermark(0) {}
+
+  // Csak az író hívhatja. Tele gyűrű esetén az új elem eldobásra kerül.
+  bool push(const T& item) {
+    uint32_t currentHead = head.load(std::memory_order_relaxed);
+    uint32_t currentTail = tail.load(std::memory_order_acquire);
+    uint32_t occupancy = currentHead - currentTail;
+
+    if (occupancy >= Capacity) {
+      overflowCount.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    buffer[currentHead & (Capacity - 1)] = item;
+    head.store(currentHead + 1, std::memory_order_release);
+    pushedCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (occupancy + 1 > highWatermark.load(std::memory_order_relaxed)) {
+      highWatermark.store(occupancy + 1, std::memory_order_relaxed);
+    }
+    return true;
+  }
+
+  // Csak az olvasó hívhatja
+  bool pop(T& item) {
+    uint32_t currentTail = tail.load(std::memory_order_relaxed);
+    uint32_t currentHead = head.load(std::memory_order_acquire);
+
+    if (currentTail == currentHead) {
+      return false;
+    }
+
+    item = buffer[currentTail & (Capacity - 1)];
+    tail.store(currentTail + 1, std::memory_order_release);
+    return true;
+  }
+
+  uint32_t size() const {
+    return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+  }
+
+  uint32_t capacity() const {
+    return Capacity;
+  }
+
+  uint32_t getPushedCount() const {
+    return pushedCount.load(std::memory_order_relaxed);
+  }
+
+  uint32_t getOverflowCount() const {
+    return overflowCount.load(std::memory_order_relaxed);
+  }
+
+  uint32_t getHighWatermark() const {
+    return highWatermark.load(std::memory_order_relaxed);
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,533 @@
+#ifndef SX127X_H
+#define SX127X_H
+
+#include <Arduino.h>
+#include "driver/spi_master.h"
+#include "esp_timer.h"
+
+// ═════════════════════════════════════════════════════════
+// SAJÁT SX1276/78 MEGHAJTÓ (KÖZÖS: TÁVIRÁNYÍTÓ + MOTORVEZÉRLŐ)
+// ═════════════════════════════════════════════════════════
+// Az Arduino LoRa könyvtár általunk használt részhalmazával azonos
+// felületű (begin / receive / parsePacket / beginPacket / ...), így a
+// LoRaCommunication és a Communication választhat a kettő között. Eltérések:
+//   - ESP-IDF spi_master, DMA-val: a FIFO egy tranzakcióban mozog, a
+//     nagyobb blokkoknál a task a DMA végéig alszik (nem pörög a CPU)
+//   - vétel után a státusz regiszterek (0x10..0x1A) egy olvasással
+//   - folyamatos vétel: RxDone után a modul vételen marad, a receive()
+//     ugyanarra a beállításra nem ír regisztert (nincs újraélesítés)
+//   - adás vége DIO0 (TxDone) megszakításra, szemaforon várva
+//
+// A meghajtó maga nem zárol: a hívó (rádió mutex) sorosítja a hívásokat.
+// A példányt a vázlat hozza létre, csak ha a saját meghajtó van kiválasztva
+// (LORA_NATIVE_DRIVER / LoRaSettings::NATIVE_DRIVER) - a pufferek ~800 bájt
+// RAM-ot foglalnak. Statikus tárolású legyen (a DMA pufferek belső RAM-ban kellenek).
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+
+// Regiszterek
+static const uint8_t SX127X_REG_FIFO = 0x00;
+static const uint8_t SX127X_REG_OP_MODE = 0x01;
+static const uint8_t SX127X_REG_FRF_MSB = 0x06;            // 0x06..0x08
+static const uint8_t SX127X_REG_PA_CONFIG = 0x09;
+static const uint8_t SX127X_REG_OCP = 0x0B;
+static const uint8_t SX127X_REG_LNA = 0x0C;
+static const uint8_t SX127X_REG_FIFO_ADDR_PTR = 0x0D;
+static const uint8_t SX127X_REG_FIFO_TX_BASE_ADDR = 0x0E;
+static const uint8_t SX127X_REG_FIFO_RX_BASE_ADDR = 0x0F;
+static const uint8_t SX127X_REG_FIFO_RX_CURRENT_ADDR = 0x10; // Vételi státusz blokk eleje
+static const uint8_t SX127X_REG_IRQ_FLAGS = 0x12;
+static const uint8_t SX127X_REG_RX_NB_BYTES = 0x13;
+static const uint8_t SX127X_REG_PKT_SNR_VALUE = 0x19;      // Utána: 0x1A PKT_RSSI_VALUE
+static const uint8_t SX127X_REG_PKT_RSSI_VALUE = 0x1A;     // Vételi státusz blokk vége
+static const uint8_t SX127X_REG_MODEM_CONFIG_1 = 0x1D;
+static const uint8_t SX127X_REG_MODEM_CONFIG_2 = 0x1E;
+static const uint8_t SX127X_REG_PREAMBLE_MSB = 0x20;       // 0x20..0x21
+static const uint8_t SX127X_REG_PAYLOAD_LENGTH = 0x22;
+static const uint8_t SX127X_REG_MODEM_CONFIG_3 = 0x26;
+static const uint8_t SX127X_REG_DETECTION_OPTIMIZE = 0x31;
+static const uint8_t SX127X_REG_DETECTION_THRESHOLD = 0x37;
+static const uint8_t SX127X_REG_SYNC_WORD = 0x39;
+static const uint8_t SX127X_REG_DIO_MAPPING_1 = 0x40;
+static const uint8_t SX127X_REG_VERSION = 0x42;
+static const uint8_t SX127X_REG_PA_DAC = 0x4D;
+
+// Üzemmódok (RegOpMode, LoRa mód bittel)
+static const uint8_t SX127X_MODE_LONG_RANGE = 0x80;
+static const uint8_t SX127X_MODE_SLEEP = 0x00;
+static const uint8_t SX127X_MODE_STDBY = 0x01;
+static const uint8_t SX127X_MODE_TX = 0x03;
+static const uint8_t SX127X_MODE_RX_CONTINUOUS = 0x05;
+
+// IRQ jelzők és DIO0 leképezés
+static const uint8_t SX127X_IRQ_TX_DONE = 0x08;
+static const uint8_t SX127X_IRQ_PAYLOAD_CRC_ERROR = 0x20;
+static const uint8_t SX127X_IRQ_RX_DONE = 0x40;
+static const uint8_t SX127X_DIO0_RX_DONE = 0x00;
+static const uint8_t SX127X_DIO0_TX_DONE = 0x40;
+
+static const uint8_t SX127X_VERSION = 0x12;
+static const int SX127X_FIFO_SIZE = 256;
+static const int SX127X_MAX_PAYLOAD = 255;
+static const int SX127X_RSSI_OFFSET_LF = 164;              // 525 MHz alatt
+static const int SX127X_RSSI_OFFSET_HF = 157;
+static const long SX127X_MID_BAND_THRESHOLD = 525E6;
+static const long SX127X_XTAL_HZ = 32000000;
+
+static const spi_host_device_t SX127X_SPI_HOST = SPI3_HOST;  // VSPI (a LoRa könyvtár busza)
+static const int SX127X_SPI_CLOCK_HZ = 8000000;
+static const int SX127X_IRQ_BURST_MIN = 32;        // Ettől a mérettől megszakításos (alvó) DMA várakozás
+static const uint32_t SX127X_TX_TIMEOUT_MS = 2000; // SF12 / 125 kHz alatt egy teljes FIFO is belefér
+static const int SX127X_RESET_PULSE_MS = 10;
+
+class Sx127x {
+private:
+  static inline Sx127x* instance = nullptr;
+
+  int ssPin;
+  int resetPin;
+  int dio0Pin;
+  int sckPin;
+  int misoPin;
+  int mosiPin;
+  long frequency;
+
+  spi_device_handle_t device;
+  SemaphoreHandle_t txDone;
+  volatile bool txPending;
+  void (*rxDoneCallback)();
+
+  // Modem állapot (a receive() ebből dönti el, kell-e regisztert írni)
+  uint8_t mode;
+  bool implicitHeader;
+  int implicitLength;
+
+  // Vételi DMA puffer (szóhatárra igazított, 4 bájtos többszörösökkel
+  // olvasva, így az IDF-nek nem kell átmeneti puffert foglalnia).
+  // A LoRa könyvtár kompatibilis parsePacket / read is ebből olvas.
+  alignas(4) uint8_t rxBuffer[SX127X_FIFO_SIZE];
+  alignas(4) uint8_t status[12];             // 0x10..0x1B
+
+  int rxLength;
+  int rxIndex;
+  int lastRssi;
+  float lastSnr;
+
+  // Adási puffer (beginPacket / write / endPacket)
+  alignas(4) uint8_t txBuffer[SX127X_FIFO_SIZE];
+  int txLength;
+
+  uint32_t crcErrors;
+  uint32_t txTimeouts;
+
+  // DIO0: adás közben TxDone (szemafor), egyébként RxDone (hívó értesítése)
+  static void IRAM_ATTR onDio0Rise() {
+    Sx127x* self = instance;
+    if (!self) {
+      return;
+    }
+    if (self->txPending) {
+      self->txPending = false;
+      BaseType_t higherPriorityTaskWoken = pdFALSE;
+      xSemaphoreGiveFromISR(self->txDone, &higherPriorityTaskWoken);
+      if (higherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
+      }
+      return;
+    }
+    if (self->rxDoneCallback) {
+      self->rxDoneCallback();
+    }
+  }
+
+  // Rövid tranzakció: polling (a megszakítás költsége nagyobb lenne az átvitelnél)
+  void transfer(uint8_t address, const uint8_t* txData, uint8_t* rxData, size_t length) {
+    spi_transaction_t transaction = {};
+    transaction.addr = address;
+    transaction.length = length * 8;
+    transaction.tx_buffer = txData;
+    transaction.rxlength = rxData ? length * 8 : 0;
+    transaction.rx_buffer = rxData;
+    if (length >= (size_t)SX127X_IRQ_BURST_MIN) {
+      spi_device_transmit(device, &transaction);
+    } else {
+      spi_device_polling_transmit(device, &transaction);
+    }
+  }
+
+  uint8_t readRegister(uint8_t address) {
+    spi_transaction_t transaction = {};
+    transaction.flags = SPI_TRANS_USE_RXDATA;
+    transaction.addr = address & 0x7F;
+    transaction.length = 8;
+    transaction.rxlength = 8;
+    spi_device_polling_transmit(device, &transaction);
+    return transaction.rx_data[0];
+  }
+
+  void writeRegister(uint8_t address, uint8_t value) {
+    spi_transaction_t transaction = {};
+    transaction.flags = SPI_TRANS_USE_TXDATA;
+    transaction.addr = address | 0x80;
+    transaction.length = 8;
+    transaction.tx_data[0] = value;
+    spi_device_polling_transmit(device, &transaction);
+  }
+
+  void burstRead(uint8_t address, uint8_t* buffer, size_t length) {
+    transfer(address & 0x7F, nullptr, buffer, length);
+  }
+
+  void burstWrite(uint8_t address, const uint8_t* buffer, size_t length) {
+    transfer(address | 0x80, buffer, nullptr, length);
+  }
+
+  void setMode(uint8_t newMode) {
+    writeRegister(SX127X_REG_OP_MODE, SX127X_MODE_LONG_RANGE | newMode);
+    mode = newMode;
+  }
+
+  void setHeaderMode(bool implicit, int length) {
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_1);
+    writeRegister(SX127X_REG_MODEM_CONFIG_1, implicit ? (config | 0x01) : (config & 0xFE));
+    if (implicit) {
+      writeRegister(SX127X_REG_PAYLOAD_LENGTH, length);
+    }
+    implicitHeader = implicit;
+    implicitLength = implicit ? length : 0;
+  }
+
+  int spreadingFactor() {
+    return readRegister(SX127X_REG_MODEM_CONFIG_2) >> 4;
+  }
+
+  long signalBandwidth() {
+    static const long BANDWIDTHS[] = { 7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000 };
+    int index = readRegister(SX127X_REG_MODEM_CONFIG_1) >> 4;
+    return index < 10 ? BANDWIDTHS[index] : 500000;
+  }
+
+  // Szimbólumidő 16 ms felett kötelező (lora_phy_profile.h: loraLowDataRateOptimize)
+  void updateLowDataRateOptimize() {
+    bool enable = ((uint64_t)1000000 << spreadingFactor()) / signalBandwidth() > 16000;
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_3);
+    writeRegister(SX127X_REG_MODEM_CONFIG_3, enable ? (config | 0x08) : (config & 0xF7));
+  }
+
+  void setFrequency(long hz) {
+    frequency = hz;
+    uint64_t frf = ((uint64_t)hz << 19) / SX127X_XTAL_HZ;
+    uint8_t bytes[3] = { (uint8_t)(frf >> 16), (uint8_t)(frf >> 8), (uint8_t)frf };
+    burstWrite(SX127X_REG_FRF_MSB, bytes, sizeof(bytes));
+  }
+
+  bool attachSpi() {
+    spi_bus_config_t bus = {};
+    bus.mosi_io_num = mosiPin;
+    bus.miso_io_num = misoPin;
+    bus.sclk_io_num = sckPin;
+    bus.quadwp_io_num = -1;
+    bus.quadhd_io_num = -1;
+    bus.max_transfer_sz = SX127X_FIFO_SIZE;
+
+    // ESP_ERR_INVALID_STATE: a busz már inicializálva (pl. újraindítás után)
+    esp_err_t result = spi_bus_initialize(SX127X_SPI_HOST, &bus, SPI_DMA_CH_AUTO);
+    if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+      return false;
+    }
+
+    spi_device_interface_config_t config = {};
+    config.address_bits = 8;                 // Regiszter cím + írás bit
+    config.mode = 0;
+    config.clock_speed_hz = SX127X_SPI_CLOCK_HZ;
+    config.spics_io_num = ssPin;             // Hardveres CS
+    config.flags = SPI_DEVICE_HALFDUPLEX;    // Egy tranzakcióban vagy írunk, vagy olvasunk
+    config.queue_size = 1;
+    return spi_bus_add_device(SX127X_SPI_HOST, &config, &device) == ESP_OK;
+  }
+
+public:
+  Sx127x()
+    : ssPin(5)
+    , resetPin(14)
+    , dio0Pin(2)
+    , sckPin(18)
+    , misoPin(19)
+    , mosiPin(23)
+    , frequency(0)
+    , device(nullptr)
+    , txDone(nullptr)
+    , txPending(false)
+    , rxDoneCallback(nullptr)
+    , mode(SX127X_MODE_SLEEP)
+    , implicitHeader(false)
+    , implicitLength(0)
+    , rxLength(0)
+    , rxIndex(0)
+    , lastRssi(0)
+    , lastSnr(0)
+    , txLength(0)
+    , crcErrors(0)
+    , txTimeouts(0) {}
+
+  // ===== LoRa KÖNYVTÁR KOMPATIBILIS FELÜLET =====
+
+  // resetPin < 0: nincs reset (a hívó már elvégezte)
+  void setPins(int ss, int reset, int dio0) {
+    ssPin = ss;
+    resetPin = reset;
+    dio0Pin = dio0;
+  }
+
+  void setSpiPins(int sck, int miso, int mosi) {
+    sckPin = sck;
+    misoPin = miso;
+    mosiPin = mosi;
+  }
+
+  int begin(long hz) {
+    if (!txDone) {
+      txDone = xSemaphoreCreateBinary();
+      if (!txDone) {
+        return 0;
+      }
+    }
+
+    if (resetPin >= 0) {
+      pinMode(resetPin, OUTPUT);
+      digitalWrite(resetPin, LOW);
+      delay(SX127X_RESET_PULSE_MS);
+      digitalWrite(resetPin, HIGH);
+      delay(SX127X_RESET_PULSE_MS);
+    }
+
+    if (!device && !attachSpi()) {
+      return 0;
+    }
+    if (readRegister(SX127X_REG_VERSION) != SX127X_VERSION) {
+      end();
+      return 0;
+    }
+
+    // A LoRa könyvtár begin() alapállapota: 17 dBm PA_BOOST, LNA boost, AGC
+    setMode(SX127X_MODE_SLEEP);
+    setFrequency(hz);
+    writeRegister(SX127X_REG_FIFO_TX_BASE_ADDR, 0);
+    writeRegister(SX127X_REG_FIFO_RX_BASE_ADDR, 0);
+    writeRegister(SX127X_REG_LNA, readRegister(SX127X_REG_LNA) | 0x03);
+    writeRegister(SX127X_REG_MODEM_CONFIG_3, 0x04);
+    writeRegister(SX127X_REG_OCP, 0x20 | 0x0B);          // 100 mA
+    writeRegister(SX127X_REG_PA_DAC, 0x84);
+    writeRegister(SX127X_REG_PA_CONFIG, 0x80 | (17 - 2));
+    setMode(SX127X_MODE_STDBY);
+    implicitHeader = false;
+    implicitLength = 0;
+
+    instance = this;
+    pinMode(dio0Pin, INPUT);
+    attachInterrupt(digitalPinToInterrupt(dio0Pin), onDio0Rise, RISING);
+    return 1;
+  }
+
+  void end() {
+    detachInterrupt(digitalPinToInterrupt(dio0Pin));
+    if (device) {
+      setMode(SX127X_MODE_SLEEP);
+      spi_bus_remove_device(device);
+      spi_bus_free(SX127X_SPI_HOST);
+      device = nullptr;
+    }
+    instance = nullptr;
+  }
+
+  void idle() {
+    setMode(SX127X_MODE_STDBY);
+  }
+
+  void sleep() {
+    setMode(SX127X_MODE_SLEEP);
+  }
+
+  // Folyamatos vétel. Ha a modul már így vesz, nem ír regisztert.
+  void receive(int size = 0) {
+    bool implicit = size > 0;
+    if (mode == SX127X_MODE_RX_CONTINUOUS && implicit == implicitHeader && size == implicitLength) {
+      return;
+    }
+    if (mode != SX127X_MODE_STDBY && mode != SX127X_MODE_SLEEP) {
+      setMode(SX127X_MODE_STDBY);
+    }
+    setHeaderMode(implicit, size);
+    writeRegister(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_RX_DONE);
+    setMode(SX127X_MODE_RX_CONTINUOUS);
+  }
+
+  // Polling: ha nincs vételen, vételre kapcsol és 0-t ad
+  int parsePacket(int size = 0) {
+    rxIndex = 0;
+    rxLength = 0;
+    bool implicit = size > 0;
+    if (mode != SX127X_MODE_RX_CONTINUOUS || implicit != implicitHeader || size != implicitLength) {
+      receive(size);
+      return 0;
+    }
+    int packetSize = readPacket(rxBuffer, sizeof(rxBuffer), lastRssi, lastSnr);
+    rxLength = packetSize < SX127X_MAX_PAYLOAD ? packetSize : SX127X_MAX_PAYLOAD;
+    return packetSize;
+  }
+
+  int available() {
+    return rxLength - rxIndex;
+  }
+
+  int read() {
+    return rxIndex < rxLength ? rxBuffer[rxIndex++] : -1;
+  }
+
+  int packetRssi() {
+    return lastRssi;
+  }
+
+  float packetSnr() {
+    return lastSnr;
+  }
+
+  int beginPacket(int implicit = false) {
+    setMode(SX127X_MODE_STDBY);
+    implicitHeader = implicit;
+    txLength = 0;
+    return 1;
+  }
+
+  size_t write(const uint8_t* data, size_t length) {
+    size_t room = SX127X_MAX_PAYLOAD - txLength;
+    if (length > room) {
+      length = room;
+    }
+    memcpy(txBuffer + txLength, data, length);
+    txLength += length;
+    return length;
+  }
+
+  // Blokkol a TxDone megszakításig (a task alszik), utána készenlét
+  int endPacket() {
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_1);
+    writeRegister(SX127X_REG_MODEM_CONFIG_1, implicitHeader ? (config | 0x01) : (config & 0xFE));
+    implicitLength = implicitHeader ? txLength : 0;
+    writeRegister(SX127X_REG_FIFO_ADDR_PTR, 0);
+    burstWrite(SX127X_REG_FIFO, txBuffer, txLength);
+    writeRegister(SX127X_REG_PAYLOAD_LENGTH, txLength);
+    writeRegister(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_TX_DONE);
+
+    xSemaphoreTake(txDone, 0);               // Esetleges régi jelzés törlése
+    txPending = true;
+    setMode(SX127X_MODE_TX);
+    bool done = xSemaphoreTake(txDone, pdMS_TO_TICKS(SX127X_TX_TIMEOUT_MS)) == pdTRUE;
+    txPending = false;
+
+    writeRegister(SX127X_REG_IRQ_FLAGS, SX127X_IRQ_TX_DONE);
+    writeRegister(SX127X_REG_DIO_MAPPING_1, SX127X_DIO0_RX_DONE);
+    if (done) {
+      mode = SX127X_MODE_STDBY;              // TxDone után a modul magától készenlétbe lép
+    } else {
+      txTimeouts++;
+      setMode(SX127X_MODE_STDBY);
+    }
+    return done ? 1 : 0;
+  }
+
+  void setSyncWord(int syncWord) {
+    writeRegister(SX127X_REG_SYNC_WORD, syncWord);
+  }
+
+  void setSpreadingFactor(int factor) {
+    factor = factor < 6 ? 6 : (factor > 12 ? 12 : factor);
+    writeRegister(SX127X_REG_DETECTION_OPTIMIZE, factor == 6 ? 0xC5 : 0xC3);
+    writeRegister(SX127X_REG_DETECTION_THRESHOLD, factor == 6 ? 0x0C : 0x0A);
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_2);
+    writeRegister(SX127X_REG_MODEM_CONFIG_2, (config & 0x0F) | (factor << 4));
+    updateLowDataRateOptimize();
+  }
+
+  void setSignalBandwidth(long hz) {
+    static const long LIMITS[] = { 7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000 };
+    int index = 0;
+    while (index < 9 && hz > LIMITS[index]) {
+      index++;
+    }
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_1);
+    writeRegister(SX127X_REG_MODEM_CONFIG_1, (config & 0x0F) | (index << 4));
+    updateLowDataRateOptimize();
+  }
+
+  void setCodingRate4(int denominator) {
+    denominator = denominator < 5 ? 5 : (denominator > 8 ? 8 : denominator);
+    uint8_t config = readRegister(SX127X_REG_MODEM_CONFIG_1);
+    writeRegister(SX127X_REG_MODEM_CONFIG_1, (config & 0xF1) | ((denominator - 4) << 1));
+  }
+
+  void setPreambleLength(long length) {
+    uint8_t bytes[2] = { (uint8_t)(length >> 8), (uint8_t)length };
+    burstWrite(SX127X_REG_PREAMBLE_MSB, bytes, sizeof(bytes));
+  }
+
+  void enableCrc() {
+    writeRegister(SX127X_REG_MODEM_CONFIG_2, readRegister(SX127X_REG_MODEM_CONFIG_2) | 0x04);
+  }
+
+  void disableCrc() {
+    writeRegister(SX127X_REG_MODEM_CONFIG_2, readRegister(SX127X_REG_MODEM_CONFIG_2) & 0xFB);
+  }
+
+  // ===== SAJÁT FELÜLET =====
+
+  // RxDone megszakításkor hívva (ISR kontextus, IRAM_ATTR függvény kell)
+  void onRxDone(void (*callback)()) {
+    rxDoneCallback = callback;
+  }
+
+  // Egy vett csomag a folyamatos vételből. Státusz blokk (cím, IRQ, hossz,
+  // SNR, RSSI) egy olvasással, FIFO egy burst-tel; a modul vételen marad.
+  // Visszatérés: a csomag teljes mérete (0: nincs csomag vagy CRC hiba).
+  int readPacket(uint8_t* buffer, size_t capacity, int& rssi, float& snr) {
+    static_assert(sizeof(status) > SX127X_REG_PKT_RSSI_VALUE - SX127X_REG_FIFO_RX_CURRENT_ADDR,
+                  "A státusz blokknak az RSSI regiszterig kell tartania");
+    burstRead(SX127X_REG_FIFO_RX_CURRENT_ADDR, status, sizeof(status));
+    uint8_t irqFlags = status[SX127X_REG_IRQ_FLAGS - SX127X_REG_FIFO_RX_CURRENT_ADDR];
+    if (!(irqFlags & SX127X_IRQ_RX_DONE)) {
+      return 0;
+    }
+    writeRegister(SX127X_REG_IRQ_FLAGS, irqFlags);
+    if (irqFlags & SX127X_IRQ_PAYLOAD_CRC_ERROR) {
+      crcErrors++;
+      return 0;
+    }
+
+    int size = implicitHeader ? implicitLength : status[SX127X_REG_RX_NB_BYTES - SX127X_REG_FIFO_RX_CURRENT_ADDR];
+    int bytesToRead = (size_t)size < capacity ? size : (int)capacity;
+    writeRegister(SX127X_REG_FIFO_ADDR_PTR, status[0]);
+    // A felkerekítés miatt túlolvasott FIFO bájtok ártalmatlanok
+    int burstLength = (bytesToRead + 3) & ~3;
+    burstRead(SX127X_REG_FIFO, rxBuffer, burstLength);
+    if (buffer != rxBuffer) {
+      memcpy(buffer, rxBuffer, bytesToRead);
+    }
+
+    snr = (int8_t)status[SX127X_REG_PKT_SNR_VALUE - SX127X_REG_FIFO_RX_CURRENT_ADDR] * 0.25f;
+    rssi = status[SX127X_REG_PKT_RSSI_VALUE - SX127X_REG_FIFO_RX_CURRENT_ADDR]
+           - (frequency < SX127X_MID_BAND_THRESHOLD ? SX127X_RSSI_OFFSET_LF : SX127X_RSSI_OFFSET_HF);
+    return size;
+  }
+
+  uint32_t getCrcErrors() const {
+    return crcErrors;
+  }
+
+  uint32_t getTxTimeouts() const {
+    return txTimeouts;
+  }
+};
+
+
+#endif
\ No newline at end of file
@@ -0,0 +1,159 @@
+#ifndef TDMA_RECEIVER_H
+#define TDMA_RECEIVER_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "settings.h"
+#include "tdma_schedule.h"
+#include "lora_communication.h"
+#include "debug_log.h"
+
+static_assert(!(TDMA_ENABLED && ADR_ENABLED), "TDMA módban az ADR nem használható (fix időrés hossz)");
+static_assert(!TDMA_ENABLED || LORA_RX_INTERRUPT_MODE, "A TDMA vétel megszakításos módot igényel");
+static_assert(TDMA_SLOT_INDEX < TDMA_SLOT_COUNT, "TDMA_SLOT_INDEX kívül esik a szuperkereten");
+static_assert(!TDMA_ENABLED || tdmaScheduleFits(LORA_PHY_PROFILE, LORA_FRAME_SIZE, TDMA_GUARD_US,
+                                                 TDMA_SLOT_COUNT, FAILSAFE_TIMEOUT_MS, LORA_IMPLICIT_HEADER),
+              "A TDMA szuperkeret nem fér bele a failsafe ablakba");
+
+// ═════════════════════════════════════════════════════════
+// TDMA VEVŐ - CSAK A SAJÁT IDŐRÉSBEN HALLGAT
+// ═════════════════════════════════════════════════════════
+// Szinkronizálás előtt (és TDMA_SYNC_LOST_SUPERFRAMES kihagyás után)
+// folyamatosan vesz. A saját csomag RxDone ideje - légidő adja az
+// időrés kezdetét, a következő egy szuperkerettel később jön. A vevő
+// addig alszik, TDMA_RX_LEAD_US-mal előtte ébred és a rés végéig hallgat.
+class TdmaReceiver {
+private:
+  enum TdmaState {
+    TDMA_ACQUIRING,              // Folyamatos vétel, szinkronra vár
+    TDMA_SLEEPING,               // Vevő kikapcsolva a következő résig
+    TDMA_LISTENING               // Saját időrés ablak nyitva
+  };
+
+  LoRaCommunication& lora;
+  TdmaState state;
+  uint32_t airtimeUs;
+  uint32_t superframeUs;
+  int64_t slotStartUs;           // A következő saját időrés kezdete
+  int consecutiveMisses;
+
+  uint32_t hitCount;
+  uint32_t missCount;
+  uint32_t collisionCount;
+  uint32_t resyncCount;
+
+  void scheduleNext(int64_t nextSlotStartUs) {
+    slotStartUs = nextSlotStartUs;
+    state = TDMA_SLEEPING;
+    lora.sleepRx();
+  }
+
+  void startAcquiring() {
+    state = TDMA_ACQUIRING;
+    lora.startRx();
+  }
+
+public:
+  TdmaReceiver(LoRaCommunication& loraCommunication)
+    : lora(loraCommunication)
+    , state(TDMA_ACQUIRING)
+    , airtimeUs(loraTimeOnAirUs(loraPhyProfile(LORA_PHY_PROFILE), LORA_FRAME_SIZE, LORA_IMPLICIT_HEADER))
+    , superframeUs(tdmaSuperframeUs(LORA_PHY_PROFILE, LORA_FRAME_SIZE, TDMA_GUARD_US, TDMA_SLOT_COUNT,
+                                    LORA_IMPLICIT_HEADER))
+    , slotStartUs(0)
+    , consecutiveMisses(0)
+    , hitCount(0)
+    , missCount(0)
+    , collisionCount(0)
+    , resyncCount(0) {}
+
+  void begin() {
+    #if DEBUG_ENABLED && DEBUG_LORA
+      debugLog.printf("🕒 TDMA: %d. rés / %d | rés: %lu µs | szuperkeret: %lu µs",
+                      TDMA_SLOT_INDEX, TDMA_SLOT_COUNT,
+                      (unsigned long)tdmaSlotLengthUs(LORA_PHY_PROFILE, LORA_FRAME_SIZE, TDMA_GUARD_US, LORA_IMPLICIT_HEADER),
+                      (unsigned long)superframeUs);
+    #endif
+  }
+
+  // A rádió task minden körében. Visszatérés: ennyi ideig (tick) kell
+  // csomagra várni - 0 esetén a task aludjon (waitUntilWake).
+  TickType_t service(int64_t nowUs) {
+    switch (state) {
+      case TDMA_ACQUIRING:
+        return pdMS_TO_TICKS(LORA_RX_WAIT_MS);
+
+      case TDMA_SLEEPING:
+        if (nowUs < slotStartUs - TDMA_RX_LEAD_US) {
+          return 0;
+        }
+        state = TDMA_LISTENING;
+        lora.startRx();
+        // fall through
+
+      case TDMA_LISTENING: {
+        int64_t windowEndUs = slotStartUs + airtimeUs + TDMA_GUARD_US;
+        if (nowUs < windowEndUs) {
+          TickType_t ticks = pdMS_TO_TICKS((windowEndUs - nowUs + 999) / 1000);
+          return ticks ? ticks : 1;
+        }
+        // A saját rés csomag nélkül telt el
+        missCount++;
+        if (++consecutiveMisses >= TDMA_SYNC_LOST_SUPERFRAMES) {
+          resyncCount++;
+          consecutiveMisses = 0;
+          startAcquiring();
+          #if DEBUG_ENABLED && DEBUG_LORA
+            debugLog.println("⚠️ TDMA: szinkron elveszett - folyamatos vétel");
+          #endif
+        } else {
+          scheduleNext(slotStartUs + superframeUs);
+        }
+        return pdMS_TO_TICKS(LORA_RX_WAIT_MS);
+      }
+    }
+    return pdMS_TO_TICKS(LORA_RX_WAIT_MS);
+  }
+
+  // Alvó állapotban a következő ébredésig blokkol
+  void waitUntilWake(int64_t nowUs) {
+    int64_t wakeUs = slotStartUs - TDMA_RX_LEAD_US;
+    if (wakeUs > nowUs) {
+      TickType_t ticks = pdMS_TO_TICKS((wakeUs - nowUs) / 1000);
+      vTaskDelay(ticks ? ticks : 1);
+    }
+  }
+
+  // Érvényes, ennek a robotnak szóló csomag (rxTimeUs: RxDone ideje)
+  void onOwnPacket(int64_t rxTimeUs) {
+    hitCount++;
+    consecutiveMisses = 0;
+    int64_t thisSlotStartUs = rxTimeUs - airtimeUs;
+    scheduleNext(thisSlotStartUs + superframeUs);
+  }
+
+  // A saját résben hibás vagy idegen keret: másik adó ütközik velünk
+  void onForeignOrCorrupt() {
+    if (state == TDMA_LISTENING) {
+      collisionCount++;
+    }
+  }
+
+  // LoRa újraindítás után újra kell szinkronizálni
+  // (a helyreállítás folyamatos vételre kapcsol)
+  void onLinkReset() {
+    state = TDMA_ACQUIRING;
+    consecutiveMisses = 0;
+  }
+
+  void dump() const {
+    uint32_t expected = hitCount + missCount;
+    debugLog.printf("🕒 TDMA %d. rés - vett: %lu | kihagyott: %lu (%.1f%%) | ütközés: %lu | újraszinkron: %lu | %s",
+                    TDMA_SLOT_INDEX, (unsigned long)hitCount, (unsigned long)missCount,
+                    expected ? 100.0f * missCount / expected : 0.0f,
+                    (unsigned long)collisionCount, (unsigned long)resyncCount,
+                    state == TDMA_ACQUIRING ? "szinkronra vár" : "szinkronban");
+  }
+};
+
+#endif
\ No newline at end of file
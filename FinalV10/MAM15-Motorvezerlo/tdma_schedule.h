@@ -0,0 +1,37 @@
+#ifndef TDMA_SCHEDULE_H
+#define TDMA_SCHEDULE_H
+
+#include <stdint.h>
+#include "lora_phy_profile.h"
+
+// ═════════════════════════════════════════════════════════
+// TDMA IDŐRÉS ÜTEMEZÉS (KÖZÖS: KOORDINÁTOR + ROBOTOK)
+// ═════════════════════════════════════════════════════════
+// Egy koordinátor (távirányító) szuperkeretenként minden robotnak egy
+// időrésben küld. Az időrés hossza az aktív PHY profil légidejéből és a
+// védőidőből adódik, így a koordinátor és a robotok ugyanazt számolják:
+//
+//   | 0. rés          | 1. rés          | ... | N-1. rés        |
+//   | csomag | védő   | csomag | védő   |     | csomag | védő   |
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+constexpr uint32_t tdmaSlotLengthUs(LoRaPhyProfileId profile, int frameLength, uint32_t guardUs,
+                                    bool implicitHeader = false) {
+  return loraTimeOnAirUs(loraPhyProfile(profile), frameLength, implicitHeader) + guardUs;
+}
+
+constexpr uint32_t tdmaSuperframeUs(LoRaPhyProfileId profile, int frameLength, uint32_t guardUs, int slotCount,
+                                    bool implicitHeader = false) {
+  return tdmaSlotLengthUs(profile, frameLength, guardUs, implicitHeader) * slotCount;
+}
+
+// A szuperkeret (egy robot adási periódusa) a failsafe ablakba is beférjen
+constexpr bool tdmaScheduleFits(LoRaPhyProfileId profile, int frameLength, uint32_t guardUs,
+                                int slotCount, uint32_t failsafeTimeoutMs, bool implicitHeader = false) {
+  return loraPhyProfileFits(profile, frameLength,
+                            (tdmaSuperframeUs(profile, frameLength, guardUs, slotCount, implicitHeader) + 999) / 1000,
+                            1, failsafeTimeoutMs, implicitHeader);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef WHEEL_ENCODER_H
+#define WHEEL_ENCODER_H
+
+#include <Arduino.h>
+#include "driver/pulse_cnt.h"
+#include "settings.h"
+#include "debug_log.h"
+
+// ═════════════════════════════════════════════════════════
+// KERÉK ENKÓDER (PCNT IMPULZUS SZÁMLÁLÓ)
+// ═════════════════════════════════════════════════════════
+// Kvadratúra (A + B láb): mindkét csatorna mindkét élén számol (4x),
+// előjeles. Egycsatornás (B láb = -1): csak az A felfutó élei, előjel
+// nélkül - az irányt a hívó adja (a kiírt kitöltés előjele).
+// A 16 bites hardver számláló túlcsordulását a meghajtó összegzi
+// (accum_count + határ figyelőpontok), így a különbség nem ugrik.
+// Ha előremenetben csökken a számláló, az A és B lábat kell felcserélni.
+class WheelEncoder {
+private:
+  static const int COUNT_LIMIT = 32767;
+
+  pcnt_unit_handle_t unit;
+  int lastCount;
+  bool quadrature;
+
+  static bool succeeded(esp_err_t result, const char* errorMessage) {
+    if (result == ESP_OK) {
+      return true;
+    }
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      debugLog.printf("%s (%d)", errorMessage, (int)result);
+    #endif
+    return false;
+  }
+
+  bool addChannel(int edgePin, int levelPin, pcnt_channel_edge_action_t risingAction,
+                  pcnt_channel_edge_action_t fallingAction) {
+    pcnt_chan_config_t channelConfig = {};
+    channelConfig.edge_gpio_num = edgePin;
+    channelConfig.level_gpio_num = levelPin;
+    pcnt_channel_handle_t channel = nullptr;
+    return succeeded(pcnt_new_channel(unit, &channelConfig, &channel), "❌ PCNT csatorna létrehozása sikertelen!") &&
+           succeeded(pcnt_channel_set_edge_action(channel, risingAction, fallingAction),
+                     "❌ PCNT él akció beállítása sikertelen!") &&
+           succeeded(pcnt_channel_set_level_action(channel, PCNT_CHANNEL_LEVEL_ACTION_KEEP,
+                                                   levelPin >= 0 ? PCNT_CHANNEL_LEVEL_ACTION_INVERSE
+                                                                 : PCNT_CHANNEL_LEVEL_ACTION_KEEP),
+                     "❌ PCNT szint akció beállítása sikertelen!");
+  }
+
+public:
+  WheelEncoder() : unit(nullptr), lastCount(0), quadrature(false) {}
+
+  bool init(int pinA, int pinB) {
+    quadrature = pinB >= 0;
+
+    pcnt_unit_config_t unitConfig = {};
+    unitConfig.low_limit = -COUNT_LIMIT;
+    unitConfig.high_limit = COUNT_LIMIT;
+    unitConfig.flags.accum_count = 1;
+    pcnt_glitch_filter_config_t filterConfig = {};
+    filterConfig.max_glitch_ns = ENCODER_GLITCH_FILTER_NS;
+
+    if (!succeeded(pcnt_new_unit(&unitConfig, &unit), "❌ PCNT egység létrehozása sikertelen!") ||
+        !succeeded(pcnt_unit_set_glitch_filter(unit, &filterConfig), "❌ PCNT zavarszűrő beállítása sikertelen!")) {
+      return false;
+    }
+
+    bool channelsReady = quadrature
+      ? addChannel(pinA, pinB, PCNT_CHANNEL_EDGE_ACTION_DECREASE, PCNT_CHANNEL_EDGE_ACTION_INCREASE) &&
+        addChannel(pinB, pinA, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_DECREASE)
+      : addChannel(pinA, -1, PCNT_CHANNEL_EDGE_ACTION_INCREASE, PCNT_CHANNEL_EDGE_ACTION_HOLD);
+
+    return channelsReady &&
+           succeeded(pcnt_unit_add_watch_point(unit, COUNT_LIMIT), "❌ PCNT figyelőpont beállítása sikertelen!") &&
+           succeeded(pcnt_unit_add_watch_point(unit, -COUNT_LIMIT), "❌ PCNT figyelőpont beállítása sikertelen!") &&
+           succeeded(pcnt_unit_enable(unit), "❌ PCNT engedélyezése sikertelen!") &&
+           succeeded(pcnt_unit_clear_count(unit), "❌ PCNT nullázása sikertelen!") &&
+           succeeded(pcnt_unit_start(unit), "❌ PCNT indítása sikertelen!");
+  }
+
+  // Az előző hívás óta számolt impulzusok (egycsatornásnál mindig >= 0)
+  int32_t readDelta() {
+    int count = lastCount;
+    pcnt_unit_get_count(unit, &count);
+    int32_t delta = (int32_t)(count - lastCount);
+    lastCount = count;
+    return delta;
+  }
+
+  bool isQuadrature() const {
+    return quadrature;
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef WHEEL_PID_H
+#define WHEEL_PID_H
+
+// ═════════════════════════════════════════════════════════
+// KERÉK FORDULATSZÁM PID (FIX ÜTEMŰ)
+// ═════════════════════════════════════════════════════════
+// Bemenet: cél és mért fordulatszám (enkóder impulzus / s), kimenet:
+// előjeles kitöltés (±outputLimit). Összetevők:
+//   - előrecsatolás: feedForward * cél - névleges motornál ez magában
+//     a nyílt hurkú kitöltés, a PID csak az eltérést (motor szórás,
+//     akkumulátor feszültség) pótolja
+//   - P a hibán, I a hiba integrálján, D a mért értéken (a cél ugrása
+//     nem ad D rúgást)
+// Integrátor visszatekeredés elleni védelem (anti-windup):
+//   - telített kimenetnél nem integrál tovább a telítés irányába
+//   - az integrátor értéke ±integralLimit között marad
+//
+// Tiszta számítás (nincs hardver, nincs időmérés) - gazdagépen is tesztelhető.
+struct WheelPidConfig {
+  float kp;                    // Kitöltés / (impulzus/s)
+  float ki;                    // Kitöltés / impulzus
+  float kd;                    // Kitöltés / (impulzus/s²)
+  float feedForward;           // Kitöltés / (impulzus/s)
+  float outputLimit;           // Max. |kitöltés|
+  float integralLimit;         // Max. |integrátor| (kitöltésben)
+  float periodSeconds;         // Szabályozási ütem
+};
+
+class WheelPid {
+private:
+  WheelPidConfig config;
+  float integral;
+  float previousMeasurement;
+  bool saturated;
+
+  float clamp(float value, float limit) const {
+    return value > limit ? limit : (value < -limit ? -limit : value);
+  }
+
+public:
+  explicit WheelPid(const WheelPidConfig& config)
+    : config(config), integral(0), previousMeasurement(0), saturated(false) {}
+
+  float update(float target, float measurement) {
+    float error = target - measurement;
+    float proportional = config.kp * error;
+    float derivative = -config.kd * (measurement - previousMeasurement) / config.periodSeconds;
+    float base = config.feedForward * target + proportional + derivative;
+    previousMeasurement = measurement;
+
+    // Feltételes integrálás: a telítést tovább mélyítő lépés elmarad
+    float candidate = clamp(integral + config.ki * error * config.periodSeconds, config.integralLimit);
+    float output = base + candidate;
+    bool pushesPastLimit = (output > config.outputLimit && error > 0) ||
+                           (output < -config.outputLimit && error < 0);
+    if (!pushesPastLimit) {
+      integral = candidate;
+    }
+
+    output = base + integral;
+    saturated = output > config.outputLimit || output < -config.outputLimit;
+    return clamp(output, config.outputLimit);
+  }
+
+  // Álló cél (0) esetén: a következő induláskor tiszta lappal
+  void reset(float measurement = 0) {
+    integral = 0;
+    previousMeasurement = measurement;
+    saturated = false;
+  }
+
+  bool isSaturated() const {
+    return saturated;
+  }
+
+  float getIntegral() const {
+    return integral;
+  }
+};
+
+#endif
\ No newline at end of file
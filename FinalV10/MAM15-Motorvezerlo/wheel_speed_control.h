@@ -0,0 +1,126 @@
+#ifndef WHEEL_SPEED_CONTROL_H
+#define WHEEL_SPEED_CONTROL_H
+
+#include <Arduino.h>
+#include <math.h>
+#include "settings.h"
+#include "debug_log.h"
+#include "wheel_encoder.h"
+#include "wheel_pid.h"
+
+static_assert(CONTROL_TICK_HZ % WHEEL_PID_HZ == 0,
+              "A WHEEL_PID_HZ a CONTROL_TICK_HZ osztója legyen (fix ütemű PID)");
+
+// ═════════════════════════════════════════════════════════
+// ZÁRT HURKÚ KERÉK FORDULATSZÁM SZABÁLYOZÁS
+// ═════════════════════════════════════════════════════════
+// A MotorControl (rámpa utáni) kitöltés parancsa itt fordulatszám cél:
+// ±255 → ±WHEEL_MAX_SPEED_CPS. Kerekenként egy PID (wheel_pid.h) a
+// vezérlési ütem minden (CONTROL_TICK_HZ / WHEEL_PID_HZ). lépésében
+// számol a PCNT enkóder különbségből. Két lépés között a kitöltés marad.
+// 0 célnál a kimenet 0 és a PID nullázódik (álló helyzetben nem "zümmög").
+class WheelSpeedControl {
+private:
+  static const int TICKS_PER_UPDATE = CONTROL_TICK_HZ / WHEEL_PID_HZ;
+
+  struct Wheel {
+    WheelEncoder encoder;
+    WheelPid pid;
+    float targetCps;
+    float measuredCps;
+    int duty;
+
+    explicit Wheel(const WheelPidConfig& config)
+      : pid(config), targetCps(0), measuredCps(0), duty(0) {}
+  };
+
+  Wheel left;
+  Wheel right;
+  int tickCounter;
+  uint32_t updateCount;
+  uint32_t saturatedCount;     // Telített kimenetű lépések (a cél nem érhető el)
+
+  static WheelPidConfig pidConfig() {
+    WheelPidConfig config;
+    config.kp = WHEEL_PID_KP;
+    config.ki = WHEEL_PID_KI;
+    config.kd = WHEEL_PID_KD;
+    config.feedForward = 255.0f / WHEEL_MAX_SPEED_CPS;
+    config.outputLimit = 255.0f;
+    config.integralLimit = WHEEL_PID_INTEGRAL_LIMIT;
+    config.periodSeconds = 1.0f / WHEEL_PID_HZ;
+    return config;
+  }
+
+  void updateWheel(Wheel& wheel, int command) {
+    int32_t counts = wheel.encoder.readDelta();
+    // Egycsatornás enkóder: az irány a legutóbb kiírt kitöltésé
+    if (!wheel.encoder.isQuadrature() && wheel.duty < 0) {
+      counts = -counts;
+    }
+    wheel.measuredCps = (float)counts * WHEEL_PID_HZ;
+    wheel.targetCps = (float)command * WHEEL_MAX_SPEED_CPS / 255.0f;
+
+    if (command == 0) {
+      wheel.pid.reset(wheel.measuredCps);
+      wheel.duty = 0;
+      return;
+    }
+    wheel.duty = (int)lroundf(wheel.pid.update(wheel.targetCps, wheel.measuredCps));
+    if (wheel.pid.isSaturated()) {
+      saturatedCount++;
+    }
+  }
+
+public:
+  WheelSpeedControl()
+    : left(pidConfig()),
+      right(pidConfig()),
+      tickCounter(0),
+      updateCount(0),
+      saturatedCount(0) {}
+
+  bool init() {
+    bool encodersReady = left.encoder.init(LEFT_ENCODER_A_PIN, LEFT_ENCODER_B_PIN) &&
+                         right.encoder.init(RIGHT_ENCODER_A_PIN, RIGHT_ENCODER_B_PIN);
+    #if DEBUG_ENABLED && DEBUG_MOTOR
+      if (encodersReady) {
+        debugLog.printf("✅ Kerék szabályozás: %d Hz PID | %s enkóder | max: %d imp/s",
+                        WHEEL_PID_HZ, left.encoder.isQuadrature() ? "kvadratúra" : "egycsatornás",
+                        WHEEL_MAX_SPEED_CPS);
+      }
+    #endif
+    return encodersReady;
+  }
+
+  // Vezérlési ütemenként hívandó. true: új kitöltés számolódott
+  bool update(int leftCommand, int rightCommand) {
+    if (++tickCounter < TICKS_PER_UPDATE) {
+      return false;
+    }
+    tickCounter = 0;
+    updateWheel(left, leftCommand);
+    updateWheel(right, rightCommand);
+    updateCount++;
+    return true;
+  }
+
+  int getLeftDuty() const {
+    return left.duty;
+  }
+
+  int getRightDuty() const {
+    return right.duty;
+  }
+
+  void dump() const {
+    debugLog.printf("🎯 Kerék szabályozás - lépés: %lu | telített: %lu",
+                    (unsigned long)updateCount, (unsigned long)saturatedCount);
+    debugLog.printf("🎯 Bal: cél %d | mért %d imp/s | kitöltés %d | I: %d",
+                    (int)left.targetCps, (int)left.measuredCps, left.duty, (int)left.pid.getIntegral());
+    debugLog.printf("🎯 Jobb: cél %d | mért %d imp/s | kitöltés %d | I: %d",
+                    (int)right.targetCps, (int)right.measuredCps, right.duty, (int)right.pid.getIntegral());
+  }
+};
+
+#endif
\ No newline at end of file
@@ -2,10 +2,14 @@
 #include "settings.h"
 #include "button_handler.h"
 #include "communication.h"
+#include "transmit_policy.h"
+#include "tdma_coordinator.h"
 
 // ===== GLOBÁLIS OBJEKTUMOK =====
 ButtonHandler buttonHandler;
 Communication communication;
+TransmitPolicy transmitPolicy;
+TdmaCoordinator tdmaCoordinator(communication);
 
 // =============================== ALAPBEÁLLÍTÁS =================================
 void setup() {
@@ -33,6 +37,10 @@ void setup() {
     }
   }
 
+  if (TdmaSettings::ENABLED) {
+    tdmaCoordinator.begin();
+  }
+
   if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_SYSTEM) {
     Serial.println("✅ Távirányító készen áll!");
     Serial.println("━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
@@ -44,17 +52,44 @@ void setup() {
 void loop() {
   // Gombok beolvasása és parancsok generálása
   byte motorCommand = buttonHandler.readMotorCommands();
-  bool speedFlag = buttonHandler.getSpeedChangeFlag();
+  uint8_t speedEventCount = buttonHandler.getSpeedEventCount();
   bool landingFlag = buttonHandler.getLandingToggleFlag();
+  int8_t throttle = buttonHandler.getThrottle();
+  int8_t steer = buttonHandler.getSteer();
+
+  // TDMA: a gombok csak a saját robot időrését töltik (a többi rés néma)
+  if (TdmaSettings::ENABLED) {
+    tdmaCoordinator.setSlotCommand(RobotSettings::TARGET_ROBOT_ID, motorCommand, throttle, steer,
+                                   speedEventCount, landingFlag, buttonHandler.getSampleStamp());
+    tdmaCoordinator.transmitNextSlot();
+    return;
+  }
+
+  // Változáskor azonnal, egyébként csak életjel küldése
+  switch (transmitPolicy.update(motorCommand, throttle, steer, speedEventCount, landingFlag,
+                                communication.getPhyProfile(), millis())) {
+    case TX_CHANGE:
+    case TX_KEEPALIVE:
+      communication.sendPacket(
+        RobotSettings::TARGET_ROBOT_ID,
+        motorCommand,
+        throttle,
+        steer,
+        speedEventCount,
+        landingFlag,
+        buttonHandler.getSampleStamp()
+      );
+      break;
+    case TX_REPEAT:
+      communication.repeatLastPacket(transmitPolicy.getCopyIndex());
+      break;
+    case TX_NONE:
+      break;
+  }
 
-  // Adat csomag küldése LoRa-n keresztül
-  communication.sendPacket(
-    RobotSettings::TARGET_ROBOT_ID,
-    motorCommand,
-    speedFlag,
-    landingFlag
-  );
+  // ADR keretek fogadása a robottól (a két adás között)
+  communication.pollDownlink(millis());
 
-  // Késleltetés a következő ciklusig
-  delay(TimingSettings::LOOP_DELAY_MS);
+  // Késleltetés a következő mintavételig
+  delay(TimingSettings::POLL_INTERVAL_MS);
 }
\ No newline at end of file
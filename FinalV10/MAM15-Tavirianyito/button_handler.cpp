@@ -1,88 +1,136 @@
-#include "button_handler.h"
-#include "settings.h"
-
-ButtonHandler::ButtonHandler() 
-  : previousSpeedButtonState(false),
-    speedChangeFlag(false),
-    previousLandingButtonState(false),
-    landingToggleFlag(false) {
-}
-
-void ButtonHandler::init() {
-  pinMode(ButtonPins::FORWARD, INPUT_PULLUP);
-  pinMode(ButtonPins::BACKWARD, INPUT_PULLUP);
-  pinMode(ButtonPins::RIGHT, INPUT_PULLUP);
-  pinMode(ButtonPins::LEFT, INPUT_PULLUP);
-  pinMode(ButtonPins::SPEED_CHANGE, INPUT_PULLUP);
-  pinMode(ButtonPins::LANDING, INPUT_PULLUP);
-
-  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_BUTTON) {
-    Serial.println("✅ Gombok inicializálva");
-  }
-}
-
-byte ButtonHandler::readMotorCommands() {
-  byte motorCommandByte = 0;
-
-  if (!digitalRead(ButtonPins::FORWARD)) {
-    motorCommandByte |= 0b00000001;
-  }
-  
-  if (!digitalRead(ButtonPins::BACKWARD)) {
-    motorCommandByte |= 0b00000010;
-  }
-  
-  if (!digitalRead(ButtonPins::RIGHT)) {
-    motorCommandByte |= 0b00000100;
-  }
-  
-  if (!digitalRead(ButtonPins::LEFT)) {
-    motorCommandByte |= 0b00001000;
-  }
-
-  handleSpeedButton();
-  handleLandingButton();
-
-  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_MOTOR && motorCommandByte != 0) {
-    Serial.print("🎮 Motor parancs: 0b");
-    Serial.println(motorCommandByte, BIN);
-  }
-
-  return motorCommandByte;
-}
-
-void ButtonHandler::handleSpeedButton() {
-  bool currentSpeedButtonState = !digitalRead(ButtonPins::SPEED_CHANGE);
-  
-  if (currentSpeedButtonState && !previousSpeedButtonState) {
-    speedChangeFlag = true;
-    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_BUTTON) {
-      Serial.println("⚡ Sebesség váltás: AKTIVÁLVA");
-    }
-  } else {
-    speedChangeFlag = false;
-  }
-  previousSpeedButtonState = currentSpeedButtonState;
-}
-
-void ButtonHandler::handleLandingButton() {
-  bool currentLandingButtonState = !digitalRead(ButtonPins::LANDING);
-  
-  // Rising edge észlelés - csak lenyomáskor toggle
-  if (currentLandingButtonState && !previousLandingButtonState) {
-    landingToggleFlag = !landingToggleFlag;
-    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_LANDING) {
-      Serial.print("🛬 Landoló toggle: ");
-      Serial.println(landingToggleFlag ? "AKTIVÁLVA" : "DEAKTIVÁLVA");
-    }
-  }
-  previousLandingButtonState = currentLandingButtonState;
-}
-
-bool ButtonHandler::getSpeedChangeFlag() {
-  return speedChangeFlag;
-}
-
-bool ButtonHandler::getLandingToggleFlag() {
-  return landingToggleFlag;
+#include "button_handler.h"
+#include "settings.h"
+#include "esp_timer.h"
+
+ButtonHandler::ButtonHandler() 
+  : previousSpeedButtonState(false),
+    speedEventCount(0),
+    previousLandingButtonState(false),
+    landingToggleFlag(false),
+    sampleStamp(0),
+    previousMotorCommand(0),
+    throttle(0),
+    steer(0) {
+}
+
+void ButtonHandler::init() {
+  pinMode(ButtonPins::FORWARD, INPUT_PULLUP);
+  pinMode(ButtonPins::BACKWARD, INPUT_PULLUP);
+  pinMode(ButtonPins::RIGHT, INPUT_PULLUP);
+  pinMode(ButtonPins::LEFT, INPUT_PULLUP);
+  pinMode(ButtonPins::SPEED_CHANGE, INPUT_PULLUP);
+  pinMode(ButtonPins::LANDING, INPUT_PULLUP);
+
+  if (DriveSettings::PROPORTIONAL) {
+    analogReadResolution(12);
+    pinMode(AnalogPins::THROTTLE, INPUT);
+    pinMode(AnalogPins::STEER, INPUT);
+  }
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_BUTTON) {
+    Serial.println("✅ Gombok inicializálva");
+  }
+}
+
+byte ButtonHandler::readMotorCommands() {
+  byte motorCommandByte = 0;
+
+  // Mintavétel ideje (késleltetés méréshez)
+  sampleStamp = (uint16_t)(esp_timer_get_time() / InstrumentationSettings::STAMP_UNIT_US);
+
+  if (!digitalRead(ButtonPins::FORWARD)) {
+    motorCommandByte |= 0b00000001;
+  }
+  
+  if (!digitalRead(ButtonPins::BACKWARD)) {
+    motorCommandByte |= 0b00000010;
+  }
+  
+  if (!digitalRead(ButtonPins::RIGHT)) {
+    motorCommandByte |= 0b00000100;
+  }
+  
+  if (!digitalRead(ButtonPins::LEFT)) {
+    motorCommandByte |= 0b00001000;
+  }
+
+  handleSpeedButton();
+  handleLandingButton();
+  readDriveAxes();
+
+  // Gyors mintavételezésnél csak a változás kerül kiírásra
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_MOTOR && motorCommandByte != previousMotorCommand) {
+    Serial.print("🎮 Motor parancs: 0b");
+    Serial.println(motorCommandByte, BIN);
+  }
+  previousMotorCommand = motorCommandByte;
+
+  return motorCommandByte;
+}
+
+void ButtonHandler::handleSpeedButton() {
+  bool currentSpeedButtonState = !digitalRead(ButtonPins::SPEED_CHANGE);
+  
+  // Egyszeri jelzés helyett számláló: egy elveszett csomag után a robot
+  // a következő csomagból pótolja a váltást
+  if (currentSpeedButtonState && !previousSpeedButtonState) {
+    speedEventCount++;
+    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_BUTTON) {
+      Serial.print("⚡ Sebesség váltás: AKTIVÁLVA #");
+      Serial.println(speedEventCount);
+    }
+  }
+  previousSpeedButtonState = currentSpeedButtonState;
+}
+
+void ButtonHandler::handleLandingButton() {
+  bool currentLandingButtonState = !digitalRead(ButtonPins::LANDING);
+  
+  // Rising edge észlelés - csak lenyomáskor toggle
+  if (currentLandingButtonState && !previousLandingButtonState) {
+    landingToggleFlag = !landingToggleFlag;
+    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_LANDING) {
+      Serial.print("🛬 Landoló toggle: ");
+      Serial.println(landingToggleFlag ? "AKTIVÁLVA" : "DEAKTIVÁLVA");
+    }
+  }
+  previousLandingButtonState = currentLandingButtonState;
+}
+
+uint8_t ButtonHandler::getSpeedEventCount() {
+  return speedEventCount;
+}
+
+bool ButtonHandler::getLandingToggleFlag() {
+  return landingToggleFlag;
+}
+
+uint16_t ButtonHandler::getSampleStamp() {
+  return sampleStamp;
+}
+
+// Gáz / kormány kar beolvasása (holtsávot, expót a robot keverője alkalmaz)
+void ButtonHandler::readDriveAxes() {
+  if (!DriveSettings::PROPORTIONAL) {
+    return;
+  }
+  throttle = readAxis(AnalogPins::THROTTLE, DriveSettings::INVERT_THROTTLE);
+  steer = readAxis(AnalogPins::STEER, DriveSettings::INVERT_STEER);
+}
+
+// ADC → -127..127 (a középállástól mért kitérés, végálláson telítve)
+int8_t ButtonHandler::readAxis(int pin, bool invert) {
+  long offset = (long)analogRead(pin) - DriveSettings::ADC_CENTER;
+  long value = offset * 127 / DriveSettings::ADC_HALF_SPAN;
+  if (value > 127) value = 127;
+  if (value < -127) value = -127;
+  return (int8_t)(invert ? -value : value);
+}
+
+int8_t ButtonHandler::getThrottle() {
+  return throttle;
+}
+
+int8_t ButtonHandler::getSteer() {
+  return steer;
 }
\ No newline at end of file
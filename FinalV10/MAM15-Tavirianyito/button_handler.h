@@ -1,27 +1,36 @@
-#ifndef BUTTON_HANDLER_H
-#define BUTTON_HANDLER_H
-
-#include <Arduino.h>
-
-class ButtonHandler {
-private:
-  // Gomb állapot változók
-  bool previousSpeedButtonState;
-  bool speedChangeFlag;
-  bool previousLandingButtonState;
-  bool landingToggleFlag;
-
-public:
-  ButtonHandler();
-  
-  void init();
-  byte readMotorCommands();
-  bool getSpeedChangeFlag();
-  bool getLandingToggleFlag();
-  
-private:
-  void handleSpeedButton();
-  void handleLandingButton();
-};
-
+#ifndef BUTTON_HANDLER_H
+#define BUTTON_HANDLER_H
+
+#include <Arduino.h>
+
+class ButtonHandler {
+private:
+  // Gomb állapot változók
+  bool previousSpeedButtonState;
+  uint8_t speedEventCount;        // Gombnyomásonként nő (körbeforduló), minden csomagban megy
+  bool previousLandingButtonState;
+  bool landingToggleFlag;
+  uint16_t sampleStamp;
+  byte previousMotorCommand;
+  int8_t throttle;                 // Arányos vezérlés: -127..127 (DriveSettings::PROPORTIONAL)
+  int8_t steer;
+
+public:
+  ButtonHandler();
+  
+  void init();
+  byte readMotorCommands();
+  uint8_t getSpeedEventCount();
+  bool getLandingToggleFlag();
+  uint16_t getSampleStamp();
+  int8_t getThrottle();
+  int8_t getSteer();
+  
+private:
+  void handleSpeedButton();
+  void handleLandingButton();
+  void readDriveAxes();
+  static int8_t readAxis(int pin, bool invert);
+};
+
 #endif
\ No newline at end of file
@@ -1,75 +1,296 @@
-#include "communication.h"
-#include "settings.h"
-
-Communication::Communication() {
-  crcCalculator = new CRC16(
-    CRCSettings::POLYNOMIAL,
-    CRCSettings::INITIAL_VALUE,
-    CRCSettings::FINAL_XOR_VALUE,
-    true,
-    true
-  );
-}
-
-Communication::~Communication() {
-  delete crcCalculator;
-}
-
-bool Communication::init() {
-  LoRa.setPins(
-    LoRaSettings::SS_PIN,
-    LoRaSettings::RESET_PIN,
-    LoRaSettings::DIO0_PIN
-  );
-  
-  if (!LoRa.begin(LoRaSettings::FREQUENCY)) {
-    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
-      Serial.println("❌ Hiba: LoRa inicializálás sikertelen!");
-    }
-    return false;
-  }
-
-  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
-    Serial.println("✅ LoRa adó mód aktiválva");
-  }
-  
-  return true;
-}
-
-void Communication::sendPacket(uint8_t robotId, byte motorCommand, bool speedFlag, bool landingFlag) {
-  // Adat csomag összeállítása
-  uint8_t transmitPacket[PacketSettings::PACKET_SIZE];
-  transmitPacket[0] = robotId;
-  transmitPacket[1] = motorCommand;
-  transmitPacket[2] = speedFlag;
-  transmitPacket[3] = landingFlag;
-
-  // CRC számítása
-  uint16_t packetCRC = calculateCRC(transmitPacket, PacketSettings::PACKET_SIZE);
-
-  // LoRa csomag küldése
-  LoRa.beginPacket();
-  LoRa.write(transmitPacket, PacketSettings::PACKET_SIZE);
-  LoRa.write(packetCRC >> 8);
-  LoRa.write(packetCRC & 0xFF);
-  LoRa.endPacket();
-
-  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION && motorCommand != 0) {
-    Serial.print("📡 Csomag elküldve - ID: ");
-    Serial.print(robotId);
-    Serial.print(" | Motor: 0b");
-    Serial.print(motorCommand, BIN);
-    Serial.print(" | Sebesség: ");
-    Serial.print(speedFlag);
-    Serial.print(" | Landoló: ");
-    Serial.print(landingFlag);
-    Serial.print(" | CRC: 0x");
-    Serial.println(packetCRC, HEX);
-  }
-}
-
-uint16_t Communication::calculateCRC(uint8_t* data, size_t length) {
-  crcCalculator->restart();
-  crcCalculator->add(data, length);
-  return crcCalculator->getCRC();
+#include "communication.h"
+#include "settings.h"
+#include "crc16_ccitt.h"
+#include "link_adr.h"
+#include "lora_sync_word.h"
+#include "sx127x.h"
+
+typedef Crc16Engine<
+  CRCSettings::POLYNOMIAL,
+  CRCSettings::INITIAL_VALUE,
+  CRCSettings::FINAL_XOR_VALUE,
+  CRCSettings::SLICE_BY_4
+> PacketCRC;
+
+// A rádió: LoRa könyvtár vagy saját SX127x meghajtó (sx127x.h, azonos felület)
+template <bool Native>
+struct LoRaRadioSelect {
+  static LoRaClass& get() { return LoRa; }
+};
+
+// A saját meghajtó példánya csak itt, NATIVE_DRIVER mellett jön létre
+template <>
+struct LoRaRadioSelect<true> {
+  static Sx127x& get() {
+    static Sx127x sx127x;
+    return sx127x;
+  }
+};
+
+static auto& radio = LoRaRadioSelect<LoRaSettings::NATIVE_DRIVER>::get();
+
+bool Communication::init() {
+  radio.setPins(
+    LoRaSettings::SS_PIN,
+    LoRaSettings::RESET_PIN,
+    LoRaSettings::DIO0_PIN
+  );
+  if constexpr (LoRaSettings::NATIVE_DRIVER) {
+    LoRaRadioSelect<true>::get().setSpiPins(LoRaSettings::SCK_PIN, LoRaSettings::MISO_PIN, LoRaSettings::MOSI_PIN);
+  }
+  
+  if (!radio.begin(LoRaSettings::FREQUENCY)) {
+    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+      Serial.println("❌ Hiba: LoRa inicializálás sikertelen!");
+    }
+    return false;
+  }
+
+  if (!setPhyProfile(phyProfile)) {
+    return false;
+  }
+
+  // A begin() visszaállítja az alap szót: a visszirányt (ADR) már a cél robot szavával hallgatjuk
+  syncWord = -1;
+  selectRobot(RobotSettings::TARGET_ROBOT_ID);
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+    Serial.println("✅ LoRa adó mód aktiválva");
+  }
+  
+  return true;
+}
+
+// PHY profil beállítása - a légidő ellenőrzésen elbukó profilt elutasítja
+bool Communication::setPhyProfile(LoRaPhyProfileId profile) {
+  const int frameLength = PacketSettings::FRAME_SIZE;
+  const LoRaPhyProfile& settings = loraPhyProfile(profile);
+  uint32_t airtimeUs = loraTimeOnAirUs(settings, frameLength, PacketSettings::IMPLICIT_HEADER);
+
+  if (!loraPhyProfileFits(profile, frameLength, TimingSettings::KEEPALIVE_INTERVAL_MS,
+                          RepeatSettings::framesPerChange(profile), RobotSettings::FAILSAFE_TIMEOUT_MS,
+                          PacketSettings::IMPLICIT_HEADER)) {
+    if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+      Serial.printf("❌ PHY profil elutasítva: %s (légidő: %lu µs)\n", settings.name, (unsigned long)airtimeUs);
+    }
+    return false;
+  }
+
+  applyLoRaPhyProfile(radio, settings);
+  phyProfile = profile;
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+    Serial.printf("📻 PHY profil: %s (SF%u / %lu kHz / 4/%u) | légidő: %lu µs (%d bájt)\n",
+                  settings.name, settings.spreadingFactor, (unsigned long)(settings.bandwidthHz / 1000),
+                  settings.codingRateDenominator, (unsigned long)airtimeUs, frameLength);
+  }
+  return true;
+}
+
+LoRaPhyProfileId Communication::getPhyProfile() {
+  return phyProfile;
+}
+
+void Communication::sendPacket(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                               uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp) {
+  sendPacket(robotId, motorCommand, throttle, steer, speedEventCount, landingFlag, sampleStamp, sequenceNumber++);
+}
+
+// Saját sorszámmal (TDMA: robotonként külön számláló)
+void Communication::sendPacket(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                               uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp, uint8_t sequence) {
+  selectRobot(robotId);
+
+  // A mezők megőrzése az ismétlésekhez (az ismétlés csak a példány sorszámában tér el)
+  lastPacket = { robotId, motorCommand, throttle, steer, speedEventCount, landingFlag, sampleStamp, sequence };
+  hasLastPacket = true;
+
+  // LoRa csomag küldése
+  uint16_t packetCRC = encodeFrame(lastPacket, 0, frameBuffer);
+  transmit(frameBuffer, PacketSettings::FRAME_SIZE);
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION && (motorCommand != 0 || throttle != 0 || steer != 0)) {
+    Serial.print("📡 Csomag elküldve - ID: ");
+    Serial.print(robotId);
+    Serial.print(" | Motor: 0b");
+    Serial.print(motorCommand, BIN);
+    if (DriveSettings::PROPORTIONAL) {
+      Serial.printf(" | Gáz: %d | Kormány: %d", throttle, steer);
+    }
+    Serial.print(" | Sebesség: ");
+    Serial.print(speedEventCount);
+    Serial.print(" | Landoló: ");
+    Serial.print(landingFlag);
+    Serial.print(" | Sorszám: ");
+    Serial.print(sequence);
+    Serial.print(" | CRC: 0x");
+    Serial.println(packetCRC, HEX);
+  }
+}
+
+// A legutóbbi csomag újabb példánya (azonos sorszám - a robot duplikátumként szűri,
+// a példány sorszámából látja, ha az első elveszett)
+void Communication::repeatLastPacket(uint8_t copyIndex) {
+  if (!hasLastPacket) {
+    return;
+  }
+  encodeFrame(lastPacket, copyIndex, frameBuffer);
+  transmit(frameBuffer, PacketSettings::FRAME_SIZE);
+}
+
+// Keret összeállítása a formátum szerint. Visszatérés: a csomag CRC-je (naplózáshoz)
+uint16_t Communication::encodeFrame(const OutgoingPacket& packet, uint8_t copyIndex, uint8_t* frame) {
+  if constexpr (PacketSettings::FORMAT != PACKET_FORMAT_V1) {
+    // v2: a robot ID a CRC-8 kezdőértéke, nem utazik; a sebesség számlálóból az
+    // alsó 3 bit megy (PACKET_V2_EVENT_MASK), a példány sorszám 2 biten
+    PacketV2 packetV2 = { packet.motorCommand, false, packet.landingFlag, packet.sequence,
+                          (uint8_t)(packet.speedEventCount & PACKET_V2_EVENT_MASK), copyIndex };
+    encodePacketV2(packetV2, packet.robotId, frame);
+    return frame[PACKET_V2_SIZE - 1];
+  }
+
+  // FEC esetén a kódolatlan keret átmeneti pufferbe kerül
+  uint8_t plainPacket[PacketSettings::PACKET_SIZE + PacketSettings::CRC_SIZE];
+  uint8_t* transmitPacket = PacketSettings::FEC ? plainPacket : frame;
+  transmitPacket[0] = packet.robotId;
+  transmitPacket[1] = packet.motorCommand;
+  transmitPacket[2] = packet.speedEventCount;
+  transmitPacket[3] = packet.landingFlag | (copyIndex << 1);
+  transmitPacket[4] = packet.sequence;
+  if constexpr (InstrumentationSettings::LATENCY_STAMP) {
+    transmitPacket[5] = packet.sampleStamp >> 8;
+    transmitPacket[6] = packet.sampleStamp & 0xFF;
+  }
+  if constexpr (DriveSettings::PROPORTIONAL) {
+    transmitPacket[PacketSettings::DRIVE_OFFSET] = (uint8_t)packet.throttle;
+    transmitPacket[PacketSettings::DRIVE_OFFSET + 1] = (uint8_t)packet.steer;
+  }
+
+  // CRC számítása
+  uint16_t packetCRC = calculateCRC(transmitPacket, PacketSettings::PACKET_SIZE);
+  transmitPacket[PacketSettings::PACKET_SIZE] = packetCRC >> 8;
+  transmitPacket[PacketSettings::PACKET_SIZE + 1] = packetCRC & 0xFF;
+
+  // Hibajavító kódolás (a robot a CRC ellenőrzés előtt dekódol)
+  if constexpr (PacketSettings::FEC) {
+    PacketFec::encode(plainPacket, sizeof(plainPacket), frame);
+  }
+  return packetCRC;
+}
+
+// A cél robot szinkron szava (TDMA-ban résenként változik, csak eltérésnél íródik)
+void Communication::selectRobot(uint8_t robotId) {
+  uint8_t word = loraSyncWord(LoRaSettings::SYNC_WORD_PER_ROBOT, robotId);
+  if (word == syncWord) {
+    return;
+  }
+  radio.setSyncWord(word);
+  syncWord = word;
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION && !TdmaSettings::ENABLED) {
+    Serial.printf("📻 Szinkron szó: 0x%02X (robot %u)\n", word, robotId);
+  }
+}
+
+void Communication::transmit(const uint8_t* frame, size_t length) {
+  radio.beginPacket(PacketSettings::IMPLICIT_HEADER);
+  radio.write(frame, length);
+  radio.endPacket();
+}
+
+uint16_t Communication::calculateCRC(uint8_t* data, size_t length) {
+  return PacketCRC::compute(data, length);
+}
+
+// ADR visszirány: a két adás között a rádió vételen áll (parsePacket polling)
+void Communication::pollDownlink(unsigned long currentTime) {
+  if (!AdrSettings::ENABLED) {
+    return;
+  }
+
+  // A robot nem erősítette meg a váltást: vissza a régi profilra
+  if (adrPending && currentTime - adrSwitchTime >= (unsigned long)AdrSettings::CONFIRM_TIMEOUT_MS) {
+    adrPending = false;
+    changeProfile(adrPreviousProfile, "megerősítés nélkül vissza");
+  }
+
+  // Nem alap profilon a robot rendszeresen jelez - ha elhallgat, vissza az alapra
+  if (!adrPending && phyProfile != LoRaSettings::PHY_PROFILE
+      && currentTime - adrLastHeardTime >= (unsigned long)AdrSettings::LINK_LOST_MS) {
+    changeProfile(LoRaSettings::PHY_PROFILE, "kapcsolatvesztés");
+  }
+
+  // Implicit fejlécnél a vett keret hosszát előre meg kell adni
+  int packetSize = radio.parsePacket(PacketSettings::IMPLICIT_HEADER ? PACKET_V2_SIZE : 0);
+  if (packetSize <= 0) {
+    return;
+  }
+
+  uint8_t frame[ADR_MAX_FRAME_SIZE];
+  int length = 0;
+  while (radio.available()) {
+    int value = radio.read();
+    if (length < ADR_MAX_FRAME_SIZE) {
+      frame[length] = value;
+    }
+    length++;
+  }
+  handleAdrFrame(frame, length, currentTime);
+}
+
+void Communication::handleAdrFrame(const uint8_t* data, int length, unsigned long currentTime) {
+  AdrFrame frame;
+  if (!decodeAdrFrameAny<PacketCRC>(data, length, RobotSettings::TARGET_ROBOT_ID, frame)) {
+    return;
+  }
+  adrLastHeardTime = currentTime;
+  LoRaPhyProfileId requested = (LoRaPhyProfileId)frame.profile;
+
+  switch (frame.type) {
+    case ADR_REQUEST: {
+      if (adrPending || requested == phyProfile) {
+        return;
+      }
+      // Csak olyan profilra nyugtáz, amelyre át is tud váltani
+      if (!loraPhyProfileFits(requested, PacketSettings::FRAME_SIZE,
+                              TimingSettings::KEEPALIVE_INTERVAL_MS, RepeatSettings::framesPerChange(requested),
+                              RobotSettings::FAILSAFE_TIMEOUT_MS, PacketSettings::IMPLICIT_HEADER)) {
+        return;
+      }
+
+      // Nyugta még a régi profilon, utána váltás
+      AdrFrame ack = { frame.robotId, ADR_ACK, frame.profile, frame.nonce };
+      uint8_t buffer[ADR_MAX_FRAME_SIZE];
+      int ackLength = encodeAdrFrameAs<PacketCRC>(PacketSettings::FORMAT, ack, buffer);
+      transmit(buffer, ackLength);
+
+      adrPreviousProfile = phyProfile;
+      adrPending = true;
+      adrSwitchTime = currentTime;
+      changeProfile(requested, "nyugtázva, megerősítésre vár");
+      break;
+    }
+
+    case ADR_BEACON:
+      if (adrPending && requested == phyProfile) {
+        adrPending = false;
+        if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+          Serial.printf("📶 ADR: %s megerősítve\n", loraPhyProfile(phyProfile).name);
+        }
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+void Communication::changeProfile(LoRaPhyProfileId profile, const char* reason) {
+  LoRaPhyProfileId from = phyProfile;
+  if (!setPhyProfile(profile)) {
+    return;
+  }
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+    Serial.printf("📶 ADR: %s → %s (%s)\n", loraPhyProfile(from).name, loraPhyProfile(profile).name, reason);
+  }
 }
\ No newline at end of file
@@ -1,23 +1,55 @@
-#ifndef COMMUNICATION_H
-#define COMMUNICATION_H
-
-#include <Arduino.h>
-#include <LoRa.h>
-#include <CRC.h>
-
-class Communication {
-private:
-  CRC16* crcCalculator;
-
-public:
-  Communication();
-  ~Communication();
-  
-  bool init();
-  void sendPacket(uint8_t robotId, byte motorCommand, bool speedFlag, bool landingFlag);
-  
-private:
-  uint16_t calculateCRC(uint8_t* data, size_t length);
-};
-
+#ifndef COMMUNICATION_H
+#define COMMUNICATION_H
+
+#include <Arduino.h>
+#include <LoRa.h>
+#include "settings.h"
+
+class Communication {
+public:
+  bool init();
+  void sendPacket(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                  uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp);
+  void sendPacket(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                  uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp, uint8_t sequence);
+  void repeatLastPacket(uint8_t copyIndex);
+  bool setPhyProfile(LoRaPhyProfileId profile);
+  LoRaPhyProfileId getPhyProfile();
+  void pollDownlink(unsigned long currentTime);
+  
+private:
+  uint8_t sequenceNumber = 0;  // Csomag sorszám (körbeforduló, a robot vesztés statisztikájához)
+  // A legutóbbi csomag mezői (ismétléshez)
+  struct OutgoingPacket {
+    uint8_t robotId;
+    byte motorCommand;
+    int8_t throttle;
+    int8_t steer;
+    uint8_t speedEventCount;
+    bool landingFlag;
+    uint16_t sampleStamp;
+    uint8_t sequence;
+  };
+  OutgoingPacket lastPacket = {};
+  bool hasLastPacket = false;
+  uint8_t frameBuffer[PacketSettings::V1_AIR_SIZE];  // v1 a nagyobb (FEC-cel kódolva)
+  LoRaPhyProfileId phyProfile = LoRaSettings::PHY_PROFILE;
+  int syncWord = -1;           // Beállított szinkron szó (-1: még nincs)
+
+  // ADR: nyugtázott váltás a robot megerősítésére vár
+  bool adrPending = false;
+  LoRaPhyProfileId adrPreviousProfile = LoRaSettings::PHY_PROFILE;
+  unsigned long adrSwitchTime = 0;
+  unsigned long adrLastHeardTime = 0;
+
+  void handleAdrFrame(const uint8_t* frame, int length, unsigned long currentTime);
+  void changeProfile(LoRaPhyProfileId profile, const char* reason);
+
+  void selectRobot(uint8_t robotId);
+  void transmit(const uint8_t* frame, size_t length);
+  uint16_t encodeFrame(const OutgoingPacket& packet, uint8_t copyIndex, uint8_t* frame);
+
+  uint16_t calculateCRC(uint8_t* data, size_t length);
+};
+
 #endif
\ No newline at end of file
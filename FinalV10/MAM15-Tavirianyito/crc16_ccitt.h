@@ -0,0 +1,85 @@
+#ifndef CRC16_CCITT_H
+#define CRC16_CCITT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ═════════════════════════════════════════════════════════
+// TÁBLÁZATOS CRC-16/CCITT (KÖZÖS: TÁVIRÁNYÍTÓ + MOTORVEZÉRLŐ)
+// ═════════════════════════════════════════════════════════
+// Bitre pontosan ugyanazt adja, mint a CRC16 könyvtár
+// reverseIn = true, reverseOut = true beállítással, de a 256 elemes
+// táblázat fordítási időben készül, futáskor bájtonként egy lookup.
+// SliceBy4 = true esetén 4 bájtot dolgoz fel egyszerre (4 x 256 elem).
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+template <uint16_t Polynomial, uint16_t InitialValue, uint16_t FinalXorValue, bool SliceBy4>
+class Crc16Engine {
+private:
+  static constexpr int TABLE_COUNT = SliceBy4 ? 4 : 1;
+
+  struct Table {
+    uint16_t entries[TABLE_COUNT][256];
+  };
+
+  static constexpr uint16_t reflect16(uint16_t value) {
+    uint16_t result = 0;
+    for (int bit = 0; bit < 16; bit++) {
+      if (value & (1u << bit)) {
+        result |= (uint16_t)(1u << (15 - bit));
+      }
+    }
+    return result;
+  }
+
+  static constexpr Table buildTable() {
+    Table table = {};
+    const uint16_t reflectedPolynomial = reflect16(Polynomial);
+
+    for (int byteValue = 0; byteValue < 256; byteValue++) {
+      uint16_t crc = (uint16_t)byteValue;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc & 1) ? (uint16_t)((crc >> 1) ^ reflectedPolynomial) : (uint16_t)(crc >> 1);
+      }
+      table.entries[0][byteValue] = crc;
+    }
+
+    // Slice-by-4: entries[k][x] = x után k darab nulla bájt hatása
+    for (int k = 1; k < TABLE_COUNT; k++) {
+      for (int byteValue = 0; byteValue < 256; byteValue++) {
+        uint16_t previous = table.entries[k - 1][byteValue];
+        table.entries[k][byteValue] = (uint16_t)((previous >> 8) ^ table.entries[0][previous & 0xFF]);
+      }
+    }
+    return table;
+  }
+
+  static constexpr Table table = buildTable();
+
+public:
+  static constexpr uint16_t REFLECTED_INITIAL_VALUE = reflect16(InitialValue);
+
+  static uint16_t compute(const uint8_t* data, size_t length) {
+    uint16_t crc = REFLECTED_INITIAL_VALUE;
+
+    if constexpr (SliceBy4) {
+      while (length >= 4) {
+        crc = table.entries[3][(data[0] ^ crc) & 0xFF]
+            ^ table.entries[2][(data[1] ^ (crc >> 8)) & 0xFF]
+            ^ table.entries[1][data[2]]
+            ^ table.entries[0][data[3]];
+        data += 4;
+        length -= 4;
+      }
+    }
+
+    while (length--) {
+      crc = (uint16_t)((crc >> 8) ^ table.entries[0][(crc ^ *data++) & 0xFF]);
+    }
+
+    return (uint16_t)(crc ^ FinalXorValue);
+  }
+};
+
+#endif
\ No newline at end of file
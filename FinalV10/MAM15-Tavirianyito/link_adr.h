@@ -0,0 +1,127 @@
+#ifndef LINK_ADR_H
+#define LINK_ADR_H
+
+#include <stdint.h>
+#include "lora_phy_profile.h"
+#include "packet_v2.h"
+
+// ═════════════════════════════════════════════════════════
+// ADAPTÍV ADATSEBESSÉG (ADR) VEZÉRLŐ KERETEK (KÖZÖS)
+// ═════════════════════════════════════════════════════════
+// A robot méri az SNR tartalékot és kér profilváltást, a távirányító
+// nyugtáz. Menet:
+//   1. robot → ADR_REQUEST(új profil, nonce)   (régi profilon)
+//   2. távirányító → ADR_ACK(új profil, nonce) (régi profilon), majd vált
+//   3. robot az ACK után vált, az első csomag után ADR_BEACON-nal megerősít
+// Megerősítés hiányában mindkét oldal visszaáll a régi profilra, tartós
+// kapcsolatvesztéskor pedig az alap (fordítási idejű) profilra, így a két
+// oldal nem maradhat tartósan eltérő profilon.
+//
+// v1 formátumban a keret mérete (ADR_FRAME_SIZE) eltér a parancs
+// csomagétól, így a vevő a méret alapján különbözteti meg őket. v2
+// (implicit fejléc, fix 4 bájt) esetén a 0xF parancs jelöli (packet_v2.h),
+// ilyenkor a nonce 4 bites - ezért mindkét oldal 4 biten számol.
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+enum AdrFrameType : uint8_t {
+  ADR_REQUEST = 1,             // robot → távirányító
+  ADR_ACK = 2,                 // távirányító → robot
+  ADR_BEACON = 3               // robot → távirányító (megerősítés / életjel)
+};
+
+constexpr uint8_t ADR_FRAME_MARKER = 0xA0;   // Felső 4 bit: ADR keret jelölő
+constexpr int ADR_PAYLOAD_SIZE = 4;          // Robot ID + jelölő|típus + profil + nonce
+constexpr int ADR_FRAME_SIZE = ADR_PAYLOAD_SIZE + 2;  // + CRC16
+constexpr int ADR_MAX_FRAME_SIZE = ADR_FRAME_SIZE > PACKET_V2_SIZE ? ADR_FRAME_SIZE : PACKET_V2_SIZE;
+constexpr uint8_t ADR_NONCE_MASK = 0x0F;
+
+struct AdrFrame {
+  uint8_t robotId;
+  AdrFrameType type;
+  uint8_t profile;
+  uint8_t nonce;               // 4 bit (ADR_NONCE_MASK)
+};
+
+template <typename Crc>
+void encodeAdrFrame(const AdrFrame& frame, uint8_t* output) {
+  output[0] = frame.robotId;
+  output[1] = ADR_FRAME_MARKER | frame.type;
+  output[2] = frame.profile;
+  output[3] = frame.nonce;
+  uint16_t crc = Crc::compute(output, ADR_PAYLOAD_SIZE);
+  output[4] = crc >> 8;
+  output[5] = crc & 0xFF;
+}
+
+template <typename Crc>
+bool decodeAdrFrame(const uint8_t* input, int length, AdrFrame& frame) {
+  if (length != ADR_FRAME_SIZE || (input[1] & 0xF0) != ADR_FRAME_MARKER) {
+    return false;
+  }
+  uint16_t receivedCrc = (input[4] << 8) | input[5];
+  if (receivedCrc != Crc::compute(input, ADR_PAYLOAD_SIZE) || input[2] >= LORA_PROFILE_COUNT) {
+    return false;
+  }
+  frame.robotId = input[0];
+  frame.type = (AdrFrameType)(input[1] & 0x0F);
+  frame.profile = input[2];
+  frame.nonce = input[3];
+  return true;
+}
+
+// v2: 4 bájtos vezérlő keret, a robot ID a CRC kezdőértéke
+inline void encodeAdrFrameV2(const AdrFrame& frame, uint8_t* output) {
+  PacketV2 packet = {
+    PACKET_V2_CONTROL_COMMAND,
+    (bool)(frame.type & 0x02),
+    (bool)(frame.type & 0x01),
+    (uint8_t)(((frame.nonce & ADR_NONCE_MASK) << 4) | (frame.profile & 0x0F)),
+    0,
+    0
+  };
+  encodePacketV2(packet, frame.robotId, output);
+}
+
+inline bool decodeAdrFrameV2(const uint8_t* input, uint8_t robotId, AdrFrame& frame) {
+  PacketV2 packet;
+  if (decodePacketV2(input, robotId, packet) != PACKET_V2_OK || packet.command != PACKET_V2_CONTROL_COMMAND) {
+    return false;
+  }
+  if ((packet.sequence & 0x0F) >= LORA_PROFILE_COUNT) {
+    return false;
+  }
+  frame.robotId = robotId;
+  frame.type = (AdrFrameType)((packet.controlFlag << 1) | packet.landingFlag);
+  frame.profile = packet.sequence & 0x0F;
+  frame.nonce = packet.sequence >> 4;
+  return true;
+}
+
+// A csomag formátumnak megfelelő keret. Visszatérés: a keret hossza.
+template <typename Crc>
+int encodeAdrFrameAs(PacketFormat format, const AdrFrame& frame, uint8_t* output) {
+  if (format == PACKET_FORMAT_V2) {
+    encodeAdrFrameV2(frame, output);
+    return PACKET_V2_SIZE;
+  }
+  encodeAdrFrame<Crc>(frame, output);
+  return ADR_FRAME_SIZE;
+}
+
+// ADR keret-e (a parancs csomagoktól a hossz vagy a v2 vezérlő parancs különbözteti meg)
+inline bool isAdrFrame(const uint8_t* input, int length) {
+  return length == ADR_FRAME_SIZE
+      || (length == PACKET_V2_SIZE && (input[0] & 0x0F) == PACKET_V2_CONTROL_COMMAND);
+}
+
+// Bármelyik formátumú, az adott robothoz tartozó keret (a hossz dönt)
+template <typename Crc>
+bool decodeAdrFrameAny(const uint8_t* input, int length, uint8_t robotId, AdrFrame& frame) {
+  if (length == PACKET_V2_SIZE) {
+    return decodeAdrFrameV2(input, robotId, frame);
+  }
+  return decodeAdrFrame<Crc>(input, length, frame) && frame.robotId == robotId;
+}
+
+#endif
\ No newline at end of file
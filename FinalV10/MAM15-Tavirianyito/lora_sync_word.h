@@ -0,0 +1,43 @@
+#ifndef LORA_SYNC_WORD_H
+#define LORA_SYNC_WORD_H
+
+#include <stdint.h>
+
+// ═════════════════════════════════════════════════════════
+// ROBOTONKÉNTI LoRa SZINKRON SZÓ (KÖZÖS: TÁVIRÁNYÍTÓ + MOTORVEZÉRLŐ)
+// ═════════════════════════════════════════════════════════
+// Az SX127x a preambulum után a szinkron szót is ellenőrzi: eltérő szónál
+// nincs RxDone, így a másik robotnak szóló csomag fel sem ébreszti a CPU-t.
+// A szó a robot ID-ből adódik, a távirányító a cél robotéval ad.
+//
+// Csak 1..7 közötti nibble-ök (az SX126x család is így képezi le), a
+// könyvtári alapérték (0x12) és a LoRaWAN szó (0x34) kimarad. Így 47 szó
+// van: az ID-k 47-enként ütköznek, ezeket a szoftveres ID / CRC szűrő fogja.
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+constexpr uint8_t LORA_DEFAULT_SYNC_WORD = 0x12;
+constexpr uint8_t LORA_LORAWAN_SYNC_WORD = 0x34;
+constexpr int LORA_ROBOT_SYNC_WORD_COUNT = 7 * 7 - 2;
+
+constexpr uint8_t loraSyncWordForRobot(uint8_t robotId) {
+  int index = robotId % LORA_ROBOT_SYNC_WORD_COUNT;
+  for (uint8_t high = 1; high <= 7; high++) {
+    for (uint8_t low = 1; low <= 7; low++) {
+      uint8_t word = (uint8_t)((high << 4) | low);
+      if (word == LORA_DEFAULT_SYNC_WORD || word == LORA_LORAWAN_SYNC_WORD) {
+        continue;
+      }
+      if (index-- == 0) {
+        return word;
+      }
+    }
+  }
+  return LORA_DEFAULT_SYNC_WORD;
+}
+
+constexpr uint8_t loraSyncWord(bool perRobot, uint8_t robotId) {
+  return perRobot ? loraSyncWordForRobot(robotId) : LORA_DEFAULT_SYNC_WORD;
+}
+
+#endif
\ No newline at end of file
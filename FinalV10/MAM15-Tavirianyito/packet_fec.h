@@ -0,0 +1,114 @@
+#ifndef PACKET_FEC_H
+#define PACKET_FEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ═════════════════════════════════════════════════════════
+// ELŐREMUTATÓ HIBAJAVÍTÁS (FEC) A V1 KERETEN (KÖZÖS)
+// ═════════════════════════════════════════════════════════
+// Kiterjesztett Hamming(8,4) (SECDED): minden 4 bites félbájtból egy 8 bites
+// kódszó. Kódszavanként 1 bithiba javítható, 2 bithiba jelezhető - így egy
+// átbillent bit miatt nem kell eldobni a csomagot. A védett keret a teljes
+// v1 csomag a CRC16-tal együtt, a CRC a dekódolás után ellenőrződik (a
+// 3+ bites, tévesen "javított" kódszót az fogja meg).
+//
+// Elrendezés (N bájtos keret → 2N bájt): az i. bájt alsó félbájtja az
+// i., a felső az (N + i). kódszó, így egy hibacsomó a két félbájt közül
+// legfeljebb az egyiket érinti.
+//
+// A kódolt méret a v1 keret duplája, ezért a vevő a hossz alapján
+// különbözteti meg a kódolatlan és az ADR keretektől.
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+constexpr int fecEncodedSize(int length) {
+  return 2 * length;
+}
+
+enum FecStatus {
+  FEC_CLEAN,                   // Nem volt bithiba
+  FEC_CORRECTED,               // Legalább egy kódszó javítva
+  FEC_UNCORRECTABLE            // Legalább egy kódszóban 2+ bithiba
+};
+
+// Kódszó bitjei: [7] teljes paritás | [6:4] p3 p2 p1 | [3:0] adat
+constexpr uint8_t hammingEncodeNibble(uint8_t nibble) {
+  const uint8_t d0 = nibble & 1, d1 = (nibble >> 1) & 1, d2 = (nibble >> 2) & 1, d3 = (nibble >> 3) & 1;
+  const uint8_t p1 = d0 ^ d1 ^ d3;
+  const uint8_t p2 = d0 ^ d2 ^ d3;
+  const uint8_t p3 = d1 ^ d2 ^ d3;
+  uint8_t codeword = (uint8_t)((nibble & 0x0F) | (p1 << 4) | (p2 << 5) | (p3 << 6));
+  uint8_t parity = 0;
+  for (int bit = 0; bit < 7; bit++) {
+    parity ^= (codeword >> bit) & 1;
+  }
+  return (uint8_t)(codeword | (parity << 7));
+}
+
+// Dekódoló táblázat: [3:0] adat, [4] javított, [5] javíthatatlan
+constexpr uint8_t FEC_ENTRY_CORRECTED = 0x10;
+constexpr uint8_t FEC_ENTRY_UNCORRECTABLE = 0x20;
+
+struct FecDecodeTable {
+  uint8_t entries[256];
+};
+
+// Minden lehetséges bájthoz a legközelebbi kódszó (a kód távolsága 4:
+// legfeljebb 1 távolságra egyetlen kódszó lehet)
+constexpr FecDecodeTable buildFecDecodeTable() {
+  FecDecodeTable table = {};
+  for (int received = 0; received < 256; received++) {
+    uint8_t entry = FEC_ENTRY_UNCORRECTABLE;
+    for (uint8_t nibble = 0; nibble < 16; nibble++) {
+      uint8_t difference = (uint8_t)(received ^ hammingEncodeNibble(nibble));
+      int distance = 0;
+      for (int bit = 0; bit < 8; bit++) {
+        distance += (difference >> bit) & 1;
+      }
+      if (distance == 0) {
+        entry = nibble;
+        break;
+      }
+      if (distance == 1) {
+        entry = (uint8_t)(nibble | FEC_ENTRY_CORRECTED);
+      }
+    }
+    table.entries[received] = entry;
+  }
+  return table;
+}
+
+class PacketFec {
+private:
+  static constexpr FecDecodeTable decodeTable = buildFecDecodeTable();
+
+public:
+  // output: fecEncodedSize(length) bájt
+  static void encode(const uint8_t* input, size_t length, uint8_t* output) {
+    for (size_t i = 0; i < length; i++) {
+      output[i] = hammingEncodeNibble(input[i] & 0x0F);
+      output[length + i] = hammingEncodeNibble(input[i] >> 4);
+    }
+  }
+
+  // length: a dekódolt keret hossza (a bemenet ennek duplája).
+  // correctedCodewords: a javított kódszavak száma
+  static FecStatus decode(const uint8_t* input, size_t length, uint8_t* output, int& correctedCodewords) {
+    uint8_t flags = 0;
+    correctedCodewords = 0;
+    for (size_t i = 0; i < length; i++) {
+      uint8_t low = decodeTable.entries[input[i]];
+      uint8_t high = decodeTable.entries[input[length + i]];
+      output[i] = (uint8_t)((low & 0x0F) | (high << 4));
+      correctedCodewords += ((low & FEC_ENTRY_CORRECTED) != 0) + ((high & FEC_ENTRY_CORRECTED) != 0);
+      flags |= low | high;
+    }
+    if (flags & FEC_ENTRY_UNCORRECTABLE) {
+      return FEC_UNCORRECTABLE;
+    }
+    return correctedCodewords ? FEC_CORRECTED : FEC_CLEAN;
+  }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef PACKET_V2_H
+#define PACKET_V2_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// ═════════════════════════════════════════════════════════
+// V2 TÖMÖR VEZÉRLŐ CSOMAG (KÖZÖS: TÁVIRÁNYÍTÓ + MOTORVEZÉRLŐ)
+// ═════════════════════════════════════════════════════════
+// 4 bájt, implicit fejléces módban (fix hossz, nincs LoRa fejléc):
+//
+//   0. bájt: [7:6] verzió (2) | [5] 0 | [4] landoló | [3:0] parancs
+//   1. bájt: sorszám
+//   2. bájt: [7:5] sebesség váltás számláló | [4:3] példány sorszám | [2:0] 0 (tartalék)
+//   3. bájt: CRC-8 (poly 0x07) a 0-2. bájtra, kezdőérték = robot ID
+//
+// A 3 bites számláló miatt egy kiesésbe eső legfeljebb 7 gombnyomás is
+// pontosan egyszer hajtódik végre (event_channel.h). A 4. bájt nem növeli a
+// légidőt: implicit fejléccel SF7-en a 3 és 4 bájtos keret is egy blokk.
+// A példány sorszám (0 = első, ismétlésnél 1..3) a v1-hez hasonlóan jelzi a
+// robotnak, ha az első példány elveszett és egy ismétlés hozta be.
+//
+// A robot ID nem utazik: a CRC kezdőértéke címez. Két különböző ID
+// kezdőértékének hatása mindig eltér (a CRC lineáris), így egy sértetlen
+// idegen csomag sosem megy át az ellenőrzésen.
+//
+// A 0xF parancs (mindkét motor előre és hátra) érvénytelen motor
+// parancsként, ezért vezérlő keretet (ADR) jelöl. Ilyenkor a 0. bájt [5:4]
+// bitjei a keret típusát, az 1. bájt a nonce-t és a profilt hordozza.
+//
+// Átállás (PACKET_FORMAT_ROLLOUT): explicit fejléc, a robot mindkét
+// formátumot elfogadja (a hossz dönt), a távirányító már v2-t küld.
+//
+// A fájl mindkét vázlatban azonos példányban van jelen (az Arduino
+// build nem lát a vázlat mappáján kívülre) - módosítani együtt kell!
+enum PacketFormat {
+  PACKET_FORMAT_V1,            // Régi formátum, explicit fejléc
+  PACKET_FORMAT_ROLLOUT,       // v2 csomag explicit fejléccel, a robot v1-et is elfogad
+  PACKET_FORMAT_V2             // Csak v2, implicit fejléc
+};
+
+constexpr uint8_t PACKET_V2_VERSION = 2;
+constexpr int PACKET_V2_SIZE = 4;
+constexpr uint8_t PACKET_V2_CONTROL_COMMAND = 0x0F;
+constexpr uint8_t PACKET_V2_EVENT_MASK = 0x07;   // 3 bites sebesség váltás számláló
+constexpr uint8_t PACKET_V2_COPY_MASK = 0x03;    // 2 bites példány sorszám
+
+struct PacketV2 {
+  uint8_t command;             // 4 bit (0xF = vezérlő keret)
+  bool controlFlag;            // Vezérlő keretnél: típus 1. bit (parancs csomagban 0)
+  bool landingFlag;            // Vezérlő keretnél: típus 0. bit
+  uint8_t sequence;            // Vezérlő keretnél: nonce (felső 4) | profil (alsó 4)
+  uint8_t speedEventCount;     // PACKET_V2_EVENT_MASK bit (vezérlő keretnél 0)
+  uint8_t copyIndex;           // PACKET_V2_COPY_MASK bit (vezérlő keretnél 0)
+};
+
+enum PacketV2Status {
+  PACKET_V2_OK,
+  PACKET_V2_BAD_VERSION,
+  PACKET_V2_CRC_ERROR          // Sérült vagy másik robotnak szól
+};
+
+struct PacketV2CrcTable {
+  uint8_t entries[256];
+};
+
+constexpr PacketV2CrcTable buildPacketV2CrcTable() {
+  PacketV2CrcTable table = {};
+  for (int byteValue = 0; byteValue < 256; byteValue++) {
+    uint8_t crc = (uint8_t)byteValue;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+    }
+    table.entries[byteValue] = crc;
+  }
+  return table;
+}
+
+class PacketV2Crc {
+private:
+  static constexpr PacketV2CrcTable table = buildPacketV2CrcTable();
+
+public:
+  static uint8_t compute(const uint8_t* data, size_t length, uint8_t seed) {
+    uint8_t crc = seed;
+    while (length--) {
+      crc = table.entries[crc ^ *data++];
+    }
+    return crc;
+  }
+};
+
+inline void encodePacketV2(const PacketV2& packet, uint8_t robotId, uint8_t* output) {
+  output[0] = (uint8_t)((PACKET_V2_VERSION << 6) | (packet.controlFlag << 5)
+                        | (packet.landingFlag << 4) | (packet.command & 0x0F));
+  output[1] = packet.sequence;
+  output[2] = (uint8_t)(((packet.speedEventCount & PACKET_V2_EVENT_MASK) << 5)
+                        | ((packet.copyIndex & PACKET_V2_COPY_MASK) << 3));
+  output[3] = PacketV2Crc::compute(output, 3, robotId);
+}
+
+inline PacketV2Status decodePacketV2(const uint8_t* input, uint8_t robotId, PacketV2& packet) {
+  if ((input[0] >> 6) != PACKET_V2_VERSION) {
+    return PACKET_V2_BAD_VERSION;
+  }
+  if (PacketV2Crc::compute(input, 3, robotId) != input[3]) {
+    return PACKET_V2_CRC_ERROR;
+  }
+  packet.command = input[0] & 0x0F;
+  packet.controlFlag = input[0] & 0x20;
+  packet.landingFlag = input[0] & 0x10;
+  packet.sequence = input[1];
+  packet.speedEventCount = input[2] >> 5;
+  packet.copyIndex = (input[2] >> 3) & PACKET_V2_COPY_MASK;
+  return PACKET_V2_OK;
+}
+
+// A parancs csomag adási mérete és fejléc módja a formátumtól függően
+constexpr int packetFrameSize(PacketFormat format, int v1FrameSize) {
+  return format == PACKET_FORMAT_V1 ? v1FrameSize : PACKET_V2_SIZE;
+}
+
+constexpr bool packetImplicitHeader(PacketFormat format) {
+  return format == PACKET_FORMAT_V2;
+}
+
+#endif
\ No newline at end of file
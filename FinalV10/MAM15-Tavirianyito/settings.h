@@ -1,58 +1,187 @@
-#ifndef SETTINGS_H
-#define SETTINGS_H
-
-// ===== DEBUG BEÁLLÍTÁSOK =====
-struct DebugSettings {
-  static const bool GLOBAL_DEBUG = true;      // Főkapcsoló
-  static const bool LOG_SYSTEM = true;        // Rendszer üzenetek
-  static const bool LOG_MOTOR = true;         // Motor parancsok
-  static const bool LOG_COMMUNICATION = true; // LoRa üzenetek
-  static const bool LOG_BUTTON = true;        // Gomb események
-  static const bool LOG_LANDING = true;       // Landoló állapot
-};
-
-// ===== LoRa KOMMUNIKÁCIÓS BEÁLLÍTÁSOK =====
-struct LoRaSettings {
-  static const int SCK_PIN = 18;
-  static const int MISO_PIN = 19;
-  static const int MOSI_PIN = 23;
-  static const int SS_PIN = 5;
-  static const int RESET_PIN = 14;
-  static const int DIO0_PIN = 2;
-  static const long FREQUENCY = 433E6;
-};
-
-// ===== CÉL ROBOT BEÁLLÍTÁSOK =====
-struct RobotSettings {
-  static const int TARGET_ROBOT_ID = 69;
-};
-
-// ===== CRC ELLENŐRZÉS BEÁLLÍTÁSAI =====
-struct CRCSettings {
-  static const uint16_t POLYNOMIAL = 0x1021;
-  static const uint16_t INITIAL_VALUE = 0xFFFF;
-  static const uint16_t FINAL_XOR_VALUE = 0x0000;
-};
-
-// ===== GOMB PIN DEFINÍCIÓK =====
-struct ButtonPins {
-  static const int FORWARD = 32;
-  static const int BACKWARD = 33;
-  static const int RIGHT = 25;
-  static const int LEFT = 26;
-  static const int SPEED_CHANGE = 27;
-  static const int LANDING = 13;
-};
-
-// ===== IDŐZÍTÉS BEÁLLÍTÁSOK =====
-struct TimingSettings {
-  static const int LOOP_DELAY_MS = 60;
-};
-
-// ===== CSOMAG BEÁLLÍTÁSOK =====
-struct PacketSettings {
-  static const int PACKET_SIZE = 4;  // Robot ID + Motor Command + Speed Flag + Landing Flag
-  static const int CRC_SIZE = 2;
-};
-
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include "lora_phy_profile.h"
+#include "tdma_schedule.h"
+#include "packet_v2.h"
+#include "packet_fec.h"
+
+// ===== DEBUG BEÁLLÍTÁSOK =====
+struct DebugSettings {
+  static const bool GLOBAL_DEBUG = true;      // Főkapcsoló
+  static const bool LOG_SYSTEM = true;        // Rendszer üzenetek
+  static const bool LOG_MOTOR = true;         // Motor parancsok
+  static const bool LOG_COMMUNICATION = true; // LoRa üzenetek
+  static const bool LOG_BUTTON = true;        // Gomb események
+  static const bool LOG_LANDING = true;       // Landoló állapot
+};
+
+// ===== LoRa KOMMUNIKÁCIÓS BEÁLLÍTÁSOK =====
+struct LoRaSettings {
+  static const int SCK_PIN = 18;
+  static const int MISO_PIN = 19;
+  static const int MOSI_PIN = 23;
+  static const int SS_PIN = 5;
+  static const int RESET_PIN = 14;
+  static const int DIO0_PIN = 2;
+  static const long FREQUENCY = 433E6;
+  static const LoRaPhyProfileId PHY_PROFILE = LORA_PROFILE_BALANCED;  // Egyezzen a robottal!
+  static const bool SYNC_WORD_PER_ROBOT = true;  // lora_sync_word.h - egyezzen a robottal!
+  static const bool NATIVE_DRIVER = false;       // true = saját SX127x meghajtó (sx127x.h) a LoRa könyvtár helyett
+};
+
+// ===== CÉL ROBOT BEÁLLÍTÁSOK =====
+struct RobotSettings {
+  static const int TARGET_ROBOT_ID = 69;
+  static const int FAILSAFE_TIMEOUT_MS = 300;  // A robot FAILSAFE_TIMEOUT_MS értéke - egyezzen!
+};
+
+// ===== CRC ELLENŐRZÉS BEÁLLÍTÁSAI =====
+struct CRCSettings {
+  static const uint16_t POLYNOMIAL = 0x1021;
+  static const uint16_t INITIAL_VALUE = 0xFFFF;
+  static const uint16_t FINAL_XOR_VALUE = 0x0000;
+  static const bool SLICE_BY_4 = false;  // true = 4 bájtos slice-by-4 (4x nagyobb táblázat)
+};
+
+// ===== GOMB PIN DEFINÍCIÓK =====
+struct ButtonPins {
+  static const int FORWARD = 32;
+  static const int BACKWARD = 33;
+  static const int RIGHT = 25;
+  static const int LEFT = 26;
+  static const int SPEED_CHANGE = 27;
+  static const int LANDING = 13;
+};
+
+// ===== ARÁNYOS VEZÉRLÉS (GÁZ / KORMÁNY) ANALÓG BEMENETEK =====
+// ADC1 lábak (a WiFi mellett is használhatók). A robot DRIVE_MODE_PROPORTIONAL
+// beállítása egyezzen! A nyomógombos (bitmaszk) parancs mellette is megy: ha a
+// karok középen állnak, a robot a gombokat követi.
+struct AnalogPins {
+  static const int THROTTLE = 34;
+  static const int STEER = 35;
+};
+
+struct DriveSettings {
+  static const bool PROPORTIONAL = false;       // true = gáz/kormány bájtok a csomagban
+  static const int ADC_CENTER = 2048;           // Kar középállás (12 bites ADC)
+  static const int ADC_HALF_SPAN = 2048;        // Középtől a végállásig
+  static const bool INVERT_THROTTLE = false;
+  static const bool INVERT_STEER = false;
+  static const int CHANGE_THRESHOLD = 3;        // Ennél kisebb elmozdulás nem változás (ADC zaj)
+};
+
+// ===== IDŐZÍTÉS BEÁLLÍTÁSOK =====
+struct TimingSettings {
+  static const int POLL_INTERVAL_MS = 5;           // Gomb mintavételezés időköze
+  static const int KEEPALIVE_INTERVAL_MS = 100;    // Életjel, ha nincs változás
+};
+
+// ===== ISMÉTLÉS VÁLTOZÁSKOR (IDŐBELI DIVERZITÁS) =====
+// Új parancs (irány, megállás, flagek) után extra példányok azonos sorszámmal,
+// az előző adás vége után véletlen [MIN_GAP, MAX_GAP] ms szünettel, hogy egy
+// rövid zavar ne vigye el mindet. A robot sorszám alapján szűri a másolatokat.
+// A példány sorszáma (0 = első) v1-ben a landoló bájt [2:1], v2-ben a 2. bájt [4:3] bitjein utazik.
+// A legnagyobb maxGapMs a robot REMOTE_REPEAT_MAX_GAP_MS beállítása (failsafe tartás) - egyezzen!
+// A copies értékek a robot REMOTE_REPEAT_COPIES_* beállításai (profil illesztés) - egyezzenek!
+struct RepeatProfile {
+  int copies;                  // Extra példányok (0..3)
+  int minGapMs;
+  int maxGapMs;
+};
+
+struct RepeatSettings {
+  static const int MAX_COPIES = 3;               // A 2 bites példány sorszám miatt
+  static constexpr RepeatProfile PER_PROFILE[LORA_PROFILE_COUNT] = {
+    { 2, 2, 8 },     // Legkisebb késés: rövid légidő, olcsó ismétlés
+    { 1, 3, 12 },    // Kiegyensúlyozott
+    { 0, 0, 0 },     // Nagy hatótáv: a hosszú légidő mellett nincs ismétlés
+  };
+
+  // Változáskor adott keretek száma (első + ismétlések)
+  static constexpr int framesPerChange(LoRaPhyProfileId profile) {
+    return 1 + PER_PROFILE[profile].copies;
+  }
+};
+
+static_assert(RepeatSettings::PER_PROFILE[LORA_PROFILE_LOWEST_LATENCY].copies <= RepeatSettings::MAX_COPIES
+              && RepeatSettings::PER_PROFILE[LORA_PROFILE_BALANCED].copies <= RepeatSettings::MAX_COPIES
+              && RepeatSettings::PER_PROFILE[LORA_PROFILE_LONG_RANGE].copies <= RepeatSettings::MAX_COPIES,
+              "Legfeljebb RepeatSettings::MAX_COPIES ismétlés adható meg");
+
+// Legalább két egymás utáni életjel elveszhet a failsafe előtt
+static_assert(TimingSettings::KEEPALIVE_INTERVAL_MS * 2 < RobotSettings::FAILSAFE_TIMEOUT_MS,
+              "KEEPALIVE_INTERVAL_MS túl nagy a robot failsafe idejéhez képest");
+
+// ===== ADAPTÍV ADATSEBESSÉG (ADR, link_adr.h) =====
+// A robot kéri a profilváltást, a távirányító nyugtáz és vált
+struct AdrSettings {
+  static const bool ENABLED = false;            // Visszirányú ADR keretek fogadása (robot ADR_ENABLED)
+  static const int CONFIRM_TIMEOUT_MS = 600;    // Megerősítés nélkül vissza (robot ADR_CONFIRM_TIMEOUT_MS)
+  static const int LINK_LOST_MS = 1500;         // Robot keret nélkül vissza az alapra (robot ADR_LINK_LOST_MS)
+};
+
+// ===== TDMA KOORDINÁTOR MÓD (tdma_schedule.h) =====
+// Egy távirányító több robotot hajt fix időrésekben. A robotok
+// TDMA_SLOT_COUNT / TDMA_SLOT_INDEX / TDMA_GUARD_US beállítása egyezzen!
+struct TdmaSettings {
+  static const bool ENABLED = false;             // true = időréses koordinátor (ADR nélkül)
+  static const int SLOT_COUNT = 2;
+  // Időrésenként a cél robot. A távirányítónak egy bemenete (gombsor) van,
+  // ez csak a TARGET_ROBOT_ID rését tölti: a többi rés néma marad.
+  static constexpr uint8_t ROBOT_IDS[SLOT_COUNT] = { 69, 70 };
+  static const uint32_t GUARD_US = 3000;         // Védőidő időrésenként (µs)
+  static const uint32_t LATE_LIMIT_US = 1000;    // Ennél később induló adás késésnek számít
+  static const int STATS_INTERVAL_MS = 5000;     // Időrés statisztika kiírás időköze
+};
+
+// ===== MŰSZEREZÉS (GOMB → PWM KÉSLELTETÉS MÉRÉS) =====
+struct InstrumentationSettings {
+  static const bool LATENCY_STAMP = false;    // Időbélyeg a csomagban (a roboton is kapcsolni!)
+  static const int STAMP_UNIT_US = 100;       // Időbélyeg felbontása (µs) - egyezzen a robottal
+};
+
+// ===== CSOMAG BEÁLLÍTÁSOK =====
+struct PacketSettings {
+  // Robot ID + Motor Command + Speed Event Counter + Landing Flag/Copy Index + Sorszám
+  // (+ 16 bites időbélyeg) (+ előjeles gáz + kormány)
+  static const int DRIVE_OFFSET = InstrumentationSettings::LATENCY_STAMP ? 7 : 5;
+  static const int PACKET_SIZE = DRIVE_OFFSET + (DriveSettings::PROPORTIONAL ? 2 : 0);
+  static const int CRC_SIZE = 2;
+
+  // Formátum (packet_v2.h) - a robottal összehangolva! Átálláskor előbb a
+  // robotok kapnak ROLLOUT-ot, utána a távirányító, végül mindkettő V2-t.
+  static constexpr PacketFormat FORMAT = PACKET_FORMAT_V1;
+  // Hibajavítás (packet_fec.h): Hamming(8,4) a teljes v1 kereten, dupla méret - egyezzen a robottal!
+  static constexpr bool FEC = false;
+  static constexpr int V1_AIR_SIZE = FEC ? fecEncodedSize(PACKET_SIZE + CRC_SIZE) : PACKET_SIZE + CRC_SIZE;
+  static constexpr int FRAME_SIZE = packetFrameSize(FORMAT, V1_AIR_SIZE);  // Adott keret mérete
+  static constexpr bool IMPLICIT_HEADER = packetImplicitHeader(FORMAT);
+};
+
+static_assert(!InstrumentationSettings::LATENCY_STAMP || PacketSettings::FORMAT == PACKET_FORMAT_V1,
+              "A késleltetés mérés időbélyege csak a v1 csomagban fér el");
+static_assert(!PacketSettings::FEC || PacketSettings::FORMAT == PACKET_FORMAT_V1,
+              "A hibajavítás (FEC) csak a v1 csomaggal használható");
+static_assert(!DriveSettings::PROPORTIONAL || PacketSettings::FORMAT == PACKET_FORMAT_V1,
+              "Az arányos vezérlés (gáz/kormány) csak a v1 csomagban fér el");
+
+static_assert(!(TdmaSettings::ENABLED && AdrSettings::ENABLED), "TDMA módban az ADR nem használható");
+static_assert(!TdmaSettings::ENABLED
+              || tdmaScheduleFits(LoRaSettings::PHY_PROFILE, PacketSettings::FRAME_SIZE,
+                                  TdmaSettings::GUARD_US, TdmaSettings::SLOT_COUNT, RobotSettings::FAILSAFE_TIMEOUT_MS,
+                                  PacketSettings::IMPLICIT_HEADER),
+              "A TDMA szuperkeret nem fér bele a robot failsafe ablakába");
+
+// A kiválasztott PHY profil légideje: változás + ismétlések beférnek az
+// életjel periódusba, és a robot failsafe ablakába is jut elég keret
+static_assert(loraPhyProfileFits(LoRaSettings::PHY_PROFILE,
+                                 PacketSettings::FRAME_SIZE,
+                                 TimingSettings::KEEPALIVE_INTERVAL_MS,
+                                 RepeatSettings::framesPerChange(LoRaSettings::PHY_PROFILE),
+                                 RobotSettings::FAILSAFE_TIMEOUT_MS,
+                                 PacketSettings::IMPLICIT_HEADER),
+              "PHY_PROFILE légideje nem fér bele az adási periódusba / failsafe ablakba");
+
 #endif
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "tdma_coordinator.h"
+#include "tdma_schedule.h"
+#include "esp_timer.h"
+
+TdmaCoordinator::TdmaCoordinator(Communication& communication)
+  : communication(communication),
+    slotLengthUs(0),
+    nextSlotStartUs(0),
+    currentSlot(0),
+    resyncCount(0),
+    lastStatsTime(0) {
+  for (int i = 0; i < TdmaSettings::SLOT_COUNT; i++) {
+    slots[i] = {};
+    slots[i].robotId = TdmaSettings::ROBOT_IDS[i];
+  }
+}
+
+void TdmaCoordinator::begin() {
+  // Az időrés hossza az aktív PHY profil légidejéből (a robotok ugyanígy számolják)
+  slotLengthUs = tdmaSlotLengthUs(communication.getPhyProfile(),
+                                  PacketSettings::FRAME_SIZE,
+                                  TdmaSettings::GUARD_US,
+                                  PacketSettings::IMPLICIT_HEADER);
+  nextSlotStartUs = esp_timer_get_time();
+  currentSlot = 0;
+
+  if (DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION) {
+    Serial.printf("🕒 TDMA koordinátor: %d rés | rés: %lu µs | szuperkeret: %lu µs\n",
+                  TdmaSettings::SLOT_COUNT, (unsigned long)slotLengthUs,
+                  (unsigned long)(slotLengthUs * TdmaSettings::SLOT_COUNT));
+  }
+}
+
+void TdmaCoordinator::setSlotCommand(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                                     uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp) {
+  for (int i = 0; i < TdmaSettings::SLOT_COUNT; i++) {
+    if (slots[i].robotId == robotId) {
+      slots[i].motorCommand = motorCommand;
+      slots[i].throttle = throttle;
+      slots[i].steer = steer;
+      slots[i].speedEventCount = speedEventCount;
+      slots[i].landingFlag = landingFlag;
+      slots[i].sampleStamp = sampleStamp;
+      slots[i].fed = true;
+      return;
+    }
+  }
+}
+
+int TdmaCoordinator::getNextSlotRobotId() {
+  return slots[currentSlot].robotId;
+}
+
+// Rövid várakozásnál aktív várakozás, egyébként delay (a pontos résindításhoz)
+void TdmaCoordinator::waitUntil(int64_t targetUs) {
+  for (;;) {
+    int64_t remainingUs = targetUs - esp_timer_get_time();
+    if (remainingUs <= 0) {
+      return;
+    }
+    if (remainingUs > 2000) {
+      delay((remainingUs - 1000) / 1000);
+    } else {
+      delayMicroseconds(remainingUs);
+    }
+  }
+}
+
+// Blokkol a következő időrés kezdetéig, majd elküldi annak csomagját
+void TdmaCoordinator::transmitNextSlot() {
+  waitUntil(nextSlotStartUs);
+
+  Slot& slot = slots[currentSlot];
+  int64_t lateUs = esp_timer_get_time() - nextSlotStartUs;
+  if (lateUs > (int64_t)TdmaSettings::LATE_LIMIT_US) {
+    slot.lateCount++;
+  }
+  if (lateUs > (int64_t)slot.maxLateUs) {
+    slot.maxLateUs = (uint32_t)lateUs;
+  }
+
+  // Bemenet nélküli rés néma (az időzítés nem változik)
+  if (slot.fed) {
+    communication.sendPacket(slot.robotId, slot.motorCommand, slot.throttle, slot.steer, slot.speedEventCount,
+                             slot.landingFlag, slot.sampleStamp, slot.sequence++);
+    slot.sentCount++;
+  }
+
+  // Fix ütemezés (nincs elcsúszás) - egy teljes résnyi késésnél újraindul
+  nextSlotStartUs += slotLengthUs;
+  if (esp_timer_get_time() - nextSlotStartUs > (int64_t)slotLengthUs) {
+    nextSlotStartUs = esp_timer_get_time();
+    resyncCount++;
+  }
+  currentSlot = (currentSlot + 1) % TdmaSettings::SLOT_COUNT;
+
+  if (currentSlot == 0 && millis() - lastStatsTime >= (unsigned long)TdmaSettings::STATS_INTERVAL_MS) {
+    lastStatsTime = millis();
+    printStats();
+  }
+}
+
+void TdmaCoordinator::printStats() {
+  if (!(DebugSettings::GLOBAL_DEBUG && DebugSettings::LOG_COMMUNICATION)) {
+    return;
+  }
+  Serial.printf("🕒 TDMA - újraütemezés: %lu\n", (unsigned long)resyncCount);
+  for (int i = 0; i < TdmaSettings::SLOT_COUNT; i++) {
+    Serial.printf("   %d. rés (ID %u)%s: küldve: %lu | késve: %lu | max késés: %lu µs\n",
+                  i, slots[i].robotId, slots[i].fed ? "" : " [néma, nincs bemenet]", (unsigned long)slots[i].sentCount,
+                  (unsigned long)slots[i].lateCount, (unsigned long)slots[i].maxLateUs);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef TDMA_COORDINATOR_H
+#define TDMA_COORDINATOR_H
+
+#include <Arduino.h>
+#include "settings.h"
+#include "communication.h"
+
+// Időréses koordinátor: szuperkeretenként minden robotnak egy csomag,
+// a saját időrése elején. A parancsokat az időrés táblázat tárolja.
+// Csak az a rés ad, amelyet setSlotCommand() már megtöltött: a többi
+// néma marad (a robotja failsafe-be áll), nem kap álló életjelet.
+class TdmaCoordinator {
+private:
+  struct Slot {
+    uint8_t robotId;
+    byte motorCommand;
+    int8_t throttle;
+    int8_t steer;
+    uint8_t speedEventCount;     // Sebesség váltás számláló (minden csomagban megy)
+    bool landingFlag;
+    uint16_t sampleStamp;
+    uint8_t sequence;
+    bool fed;                    // Van bemenete (setSlotCommand)
+    uint32_t sentCount;
+    uint32_t lateCount;
+    uint32_t maxLateUs;
+  };
+
+  Communication& communication;
+  Slot slots[TdmaSettings::SLOT_COUNT];
+  uint32_t slotLengthUs;
+  int64_t nextSlotStartUs;
+  int currentSlot;
+  uint32_t resyncCount;
+  unsigned long lastStatsTime;
+
+  void waitUntil(int64_t targetUs);
+  void printStats();
+
+public:
+  TdmaCoordinator(Communication& communication);
+
+  void begin();
+  void setSlotCommand(uint8_t robotId, byte motorCommand, int8_t throttle, int8_t steer,
+                      uint8_t speedEventCount, bool landingFlag, uint16_t sampleStamp);
+  int getNextSlotRobotId();
+  void transmitNextSlot();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "transmit_policy.h"
+#include "settings.h"
+
+TransmitPolicy::TransmitPolicy()
+  : hasSent(false),
+    lastState(0),
+    lastThrottle(0),
+    lastSteer(0),
+    repeatsLeft(0),
+    copyIndex(0),
+    lastSendTime(0),
+    nextGapMs(0),
+    changeCount(0),
+    repeatCount(0),
+    keepaliveCount(0) {
+}
+
+// Az előző adás vége után véletlen szünet (a rádió az adás alatt blokkol)
+static unsigned long repeatGapMs(LoRaPhyProfileId profile) {
+  const RepeatProfile& repeat = RepeatSettings::PER_PROFILE[profile];
+  uint32_t airtimeUs = loraTimeOnAirUs(loraPhyProfile(profile), PacketSettings::FRAME_SIZE,
+                                       PacketSettings::IMPLICIT_HEADER);
+  return (airtimeUs + 999) / 1000 + random(repeat.minGapMs, repeat.maxGapMs + 1);
+}
+
+// A kar elmozdulása csak a zajküszöb felett számít változásnak
+static bool axisChanged(int8_t value, int8_t previous) {
+  return abs(value - previous) >= DriveSettings::CHANGE_THRESHOLD;
+}
+
+TransmitAction TransmitPolicy::update(byte motorCommand, int8_t throttle, int8_t steer, uint8_t speedEventCount,
+                                      bool landingFlag, LoRaPhyProfileId profile, unsigned long currentTime) {
+  // Motor parancs (alsó 4 bit) + landoló flag + a teljes sebesség számláló
+  // (minden gombnyomás változás, akkor is, ha két mintavétel közé kettő esik)
+  uint16_t state = (motorCommand & 0x0F) | (landingFlag << 4) | (speedEventCount << 8);
+
+  if (!hasSent || state != lastState || axisChanged(throttle, lastThrottle) || axisChanged(steer, lastSteer)) {
+    hasSent = true;
+    lastState = state;
+    lastThrottle = throttle;
+    lastSteer = steer;
+    repeatsLeft = RepeatSettings::PER_PROFILE[profile].copies;
+    copyIndex = 0;
+    lastSendTime = currentTime;
+    nextGapMs = repeatGapMs(profile);
+    changeCount++;
+    return TX_CHANGE;
+  }
+
+  if (repeatsLeft > 0 && currentTime - lastSendTime >= nextGapMs) {
+    repeatsLeft--;
+    copyIndex++;
+    lastSendTime = currentTime;
+    nextGapMs = repeatGapMs(profile);
+    repeatCount++;
+    return TX_REPEAT;
+  }
+
+  if (currentTime - lastSendTime >= (unsigned long)TimingSettings::KEEPALIVE_INTERVAL_MS) {
+    lastSendTime = currentTime;
+    keepaliveCount++;
+    return TX_KEEPALIVE;
+  }
+
+  return TX_NONE;
+}
+
+uint8_t TransmitPolicy::getCopyIndex() {
+  return copyIndex;
+}
+
+uint32_t TransmitPolicy::getChangeCount() {
+  return changeCount;
+}
+
+uint32_t TransmitPolicy::getRepeatCount() {
+  return repeatCount;
+}
+
+uint32_t TransmitPolicy::getKeepaliveCount() {
+  return keepaliveCount;
+}
\ No newline at end of file
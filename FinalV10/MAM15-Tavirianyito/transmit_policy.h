@@ -0,0 +1,45 @@
+#ifndef TRANSMIT_POLICY_H
+#define TRANSMIT_POLICY_H
+
+#include <Arduino.h>
+#include "lora_phy_profile.h"
+
+// Mit kell az adott ciklusban küldeni
+enum TransmitAction {
+  TX_NONE,       // Nincs küldés
+  TX_CHANGE,     // Állapot változás - azonnal, új sorszámmal
+  TX_REPEAT,     // A legutóbbi csomag ismétlése (azonos sorszám)
+  TX_KEEPALIVE   // Változatlan állapot, életjel új sorszámmal
+};
+
+// Változás vezérelt küldés: új parancs/flag azonnal megy (a PHY profil
+// szerinti, véletlen közű ismétlésekkel - RepeatSettings), egyébként csak
+// KEEPALIVE_INTERVAL_MS-enként egy életjel.
+class TransmitPolicy {
+private:
+  bool hasSent;
+  uint16_t lastState;          // Parancs + landoló + sebesség számláló
+  int8_t lastThrottle;         // Arányos vezérlés: az utoljára elküldött karállás
+  int8_t lastSteer;
+  int repeatsLeft;
+  uint8_t copyIndex;           // Az utolsó ismétlés példány sorszáma (1..)
+  unsigned long lastSendTime;
+  unsigned long nextGapMs;     // Következő ismétlésig: légidő + véletlen szünet
+
+  uint32_t changeCount;
+  uint32_t repeatCount;
+  uint32_t keepaliveCount;
+
+public:
+  TransmitPolicy();
+
+  TransmitAction update(byte motorCommand, int8_t throttle, int8_t steer, uint8_t speedEventCount,
+                        bool landingFlag, LoRaPhyProfileId profile, unsigned long currentTime);
+  uint8_t getCopyIndex();
+
+  uint32_t getChangeCount();
+  uint32_t getRepeatCount();
+  uint32_t getKeepaliveCount();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef TEST_STUB_ARDUINO_H
+#define TEST_STUB_ARDUINO_H
+
+// Gazdagépes tesztekhez: az Arduino / ESP32 mag általunk használt része.
+// A láb és megszakítás hívások csak feljegyzik az utolsó állapotot, az idő
+// (millis) a teszt által léptetett stubMillis, a delayMicroseconds csak a
+// stubMicros számlálót lépteti, a soros port és a LEDC nem ír ki semmit.
+#include <stdarg.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define RISING 3
+#define IRAM_ATTR
+
+struct StubInterrupt {
+  int pin;
+  void (*handler)();
+};
+
+inline StubInterrupt stubInterrupt = {-1, nullptr};
+inline unsigned long stubMillis = 0;
+inline unsigned long stubMicros = 0;
+
+struct StubSerial {
+  size_t write(const uint8_t*, size_t length) {
+    return length;
+  }
+  int printf(const char*, ...) {
+    return 0;
+  }
+};
+
+inline StubSerial Serial;
+
+inline unsigned long millis() {
+  return stubMillis;
+}
+
+inline void delayMicroseconds(unsigned int us) {
+  stubMicros += us;
+}
+
+inline uint32_t getCpuFrequencyMhz() {
+  return 240;
+}
+
+inline bool ledcAttach(int, uint32_t, uint8_t) {
+  return true;
+}
+
+inline void ledcWrite(int, uint32_t) {}
+
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+inline void delay(unsigned long) {}
+
+inline int digitalPinToInterrupt(int pin) {
+  return pin;
+}
+
+inline void attachInterrupt(int pin, void (*handler)(), int) {
+  stubInterrupt.pin = pin;
+  stubInterrupt.handler = handler;
+}
+
+inline void detachInterrupt(int pin) {
+  if (stubInterrupt.pin == pin) {
+    stubInterrupt.handler = nullptr;
+  }
+}
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef TEST_STUB_MCPWM_PRELUDE_H
+#define TEST_STUB_MCPWM_PRELUDE_H
+
+// Az ESP-IDF MCPWM felület általunk használt része. A függvényeket a
+// teszt valósítja meg (pl. árnyék regiszteres modell).
+#include <stdint.h>
+
+typedef int esp_err_t;
+#ifndef ESP_OK
+#define ESP_OK 0
+#endif
+
+typedef struct mcpwm_timer_t* mcpwm_timer_handle_t;
+typedef struct mcpwm_oper_t* mcpwm_oper_handle_t;
+typedef struct mcpwm_cmpr_t* mcpwm_cmpr_handle_t;
+typedef struct mcpwm_gen_t* mcpwm_gen_handle_t;
+typedef struct mcpwm_sync_t* mcpwm_sync_handle_t;
+
+typedef enum { MCPWM_TIMER_CLK_SRC_DEFAULT } mcpwm_timer_clock_source_t;
+typedef enum { MCPWM_TIMER_COUNT_MODE_PAUSE, MCPWM_TIMER_COUNT_MODE_UP } mcpwm_timer_count_mode_t;
+typedef enum { MCPWM_TIMER_DIRECTION_UP, MCPWM_TIMER_DIRECTION_DOWN } mcpwm_timer_direction_t;
+typedef enum { MCPWM_TIMER_EVENT_EMPTY, MCPWM_TIMER_EVENT_FULL } mcpwm_timer_event_t;
+typedef enum {
+  MCPWM_GEN_ACTION_KEEP,
+  MCPWM_GEN_ACTION_LOW,
+  MCPWM_GEN_ACTION_HIGH,
+  MCPWM_GEN_ACTION_TOGGLE
+} mcpwm_generator_action_t;
+typedef enum { MCPWM_TIMER_START_NO_STOP } mcpwm_timer_start_stop_cmd_t;
+
+typedef struct {
+  int group_id;
+  mcpwm_timer_clock_source_t clk_src;
+  uint32_t resolution_hz;
+  mcpwm_timer_count_mode_t count_mode;
+  uint32_t period_ticks;
+  int intr_priority;
+  struct {
+    uint32_t update_period_on_empty : 1;
+    uint32_t update_period_on_sync : 1;
+  } flags;
+} mcpwm_timer_config_t;
+
+typedef struct {
+  int group_id;
+  int intr_priority;
+  struct {
+    uint32_t update_gen_action_on_tez : 1;
+    uint32_t update_gen_action_on_tep : 1;
+    uint32_t update_gen_action_on_sync : 1;
+    uint32_t update_dead_time_on_tez : 1;
+  } flags;
+} mcpwm_operator_config_t;
+
+typedef struct {
+  int intr_priority;
+  struct {
+    uint32_t update_cmp_on_tez : 1;
+    uint32_t update_cmp_on_tep : 1;
+    uint32_t update_cmp_on_sync : 1;
+  } flags;
+} mcpwm_comparator_config_t;
+
+typedef struct {
+  int gen_gpio_num;
+  struct {
+    uint32_t invert_pwm : 1;
+  } flags;
+} mcpwm_generator_config_t;
+
+typedef struct {
+  int reserved;
+} mcpwm_soft_sync_config_t;
+
+typedef struct {
+  mcpwm_sync_handle_t sync_src;
+  uint32_t count_value;
+  mcpwm_timer_direction_t direction;
+} mcpwm_timer_sync_phase_config_t;
+
+typedef struct {
+  mcpwm_timer_direction_t direction;
+  mcpwm_timer_event_t event;
+  mcpwm_generator_action_t action;
+} mcpwm_gen_timer_event_action_t;
+
+typedef struct {
+  mcpwm_timer_direction_t direction;
+  mcpwm_cmpr_handle_t comparator;
+  mcpwm_generator_action_t action;
+} mcpwm_gen_compare_event_action_t;
+
+#define MCPWM_GEN_TIMER_EVENT_ACTION(dir, ev, act) \
+  (mcpwm_gen_timer_event_action_t){ .direction = dir, .event = ev, .action = act }
+#define MCPWM_GEN_COMPARE_EVENT_ACTION(dir, cmp, act) \
+  (mcpwm_gen_compare_event_action_t){ .direction = dir, .comparator = cmp, .action = act }
+
+esp_err_t mcpwm_new_timer(const mcpwm_timer_config_t* config, mcpwm_timer_handle_t* timer);
+esp_err_t mcpwm_new_operator(const mcpwm_operator_config_t* config, mcpwm_oper_handle_t* oper);
+esp_err_t mcpwm_operator_connect_timer(mcpwm_oper_handle_t oper, mcpwm_timer_handle_t timer);
+esp_err_t mcpwm_new_comparator(mcpwm_oper_handle_t oper, const mcpwm_comparator_config_t* config,
+                               mcpwm_cmpr_handle_t* comparator);
+esp_err_t mcpwm_new_generator(mcpwm_oper_handle_t oper, const mcpwm_generator_config_t* config,
+                              mcpwm_gen_handle_t* generator);
+esp_err_t mcpwm_generator_set_action_on_timer_event(mcpwm_gen_handle_t generator, mcpwm_gen_timer_event_action_t action);
+esp_err_t mcpwm_generator_set_action_on_compare_event(mcpwm_gen_handle_t generator,
+                                                      mcpwm_gen_compare_event_action_t action);
+esp_err_t mcpwm_comparator_set_compare_value(mcpwm_cmpr_handle_t comparator, uint32_t ticks);
+esp_err_t mcpwm_new_soft_sync_src(const mcpwm_soft_sync_config_t* config, mcpwm_sync_handle_t* sync);
+esp_err_t mcpwm_soft_sync_activate(mcpwm_sync_handle_t sync);
+esp_err_t mcpwm_timer_set_phase_on_sync(mcpwm_timer_handle_t timer, const mcpwm_timer_sync_phase_config_t* config);
+esp_err_t mcpwm_timer_enable(mcpwm_timer_handle_t timer);
+esp_err_t mcpwm_timer_start_stop(mcpwm_timer_handle_t timer, mcpwm_timer_start_stop_cmd_t command);
+
+#endif
@@ -0,0 +1,10 @@
+#ifndef TEST_STUB_ESP_CPU_H
+#define TEST_STUB_ESP_CPU_H
+
+#include <stdint.h>
+
+inline uint32_t esp_cpu_get_cycle_count() {
+  return 0;
+}
+
+#endif
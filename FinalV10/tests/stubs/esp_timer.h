@@ -0,0 +1,6 @@
+#ifndef TEST_STUB_ESP_TIMER_H
+#define TEST_STUB_ESP_TIMER_H
+
+#include <stdint.h>
+
+#endif
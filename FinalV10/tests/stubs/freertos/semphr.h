@@ -0,0 +1,30 @@
+#ifndef TEST_STUB_SEMPHR_H
+#define TEST_STUB_SEMPHR_H
+
+// Egyszálú teszthez: a bináris szemafor egy jelző, a várakozás nem blokkol
+// (az "ISR" a tesztben szinkron, a Take előtt fut le)
+#include "FreeRTOS.h"
+
+struct StubSemaphore {
+  bool given;
+};
+
+typedef StubSemaphore* SemaphoreHandle_t;
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return new StubSemaphore{false};
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t) {
+  bool given = semaphore->given;
+  semaphore->given = false;
+  return given ? pdTRUE : pdFALSE;
+}
+
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore, BaseType_t* higherPriorityTaskWoken) {
+  semaphore->given = true;
+  *higherPriorityTaskWoken = pdFALSE;
+  return pdTRUE;
+}
+
+#endif
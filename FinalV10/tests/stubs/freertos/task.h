@@ -0,0 +1,23 @@
+#ifndef TEST_STUB_TASK_H
+#define TEST_STUB_TASK_H
+
+// Egyszálú teszthez: a task nem indul el (a napló sorai a pufferben maradnak),
+// a kritikus szakasz üres
+#include "FreeRTOS.h"
+
+typedef void* TaskHandle_t;
+typedef int portMUX_TYPE;
+
+#define pdPASS 1
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portMUX_INITIALIZE(mux) (*(mux) = 0)
+#define portENTER_CRITICAL_SAFE(mux)
+#define portEXIT_CRITICAL_SAFE(mux)
+
+inline BaseType_t xTaskCreatePinnedToCore(void (*)(void*), const char*, uint32_t, void*, int, TaskHandle_t*, int) {
+  return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t) {}
+
+#endif
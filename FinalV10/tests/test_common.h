@@ -0,0 +1,43 @@
+#ifndef TEST_COMMON_H
+#define TEST_COMMON_H
+
+// ═════════════════════════════════════════════════════════
+// GAZDAGÉPES TESZTEK KÖZÖS SEGÉDEI
+// ═════════════════════════════════════════════════════════
+// Nincs keretrendszer: a CHECK hibánál kiír és számol, a main a
+// testExitCode()-dal tér vissza (0 = minden rendben).
+#include <chrono>
+#include <cstdio>
+
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(condition)                                                    \
+  do {                                                                      \
+    testChecks++;                                                           \
+    if (!(condition)) {                                                     \
+      testFailures++;                                                       \
+      std::printf("HIBA %s:%d: %s\n", __FILE__, __LINE__, #condition);      \
+    }                                                                       \
+  } while (0)
+
+static int testExitCode(const char* name) {
+  std::printf("%s: %d ellenőrzés, %d hiba\n", name, testChecks, testFailures);
+  return testFailures ? 1 : 0;
+}
+
+// Az optimalizáló ne dobja el a mért eredményt
+static volatile unsigned long benchmarkSink;
+
+// Egy művelet átlagos ideje (ns): body iterations-szor fut
+template <typename Body>
+static double benchmarkNs(long iterations, Body body) {
+  auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; i++) {
+    body(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+#endif
@@ -0,0 +1,99 @@
+// CRC-16/CCITT (crc16_ccitt.h): ismert ellenőrző értékek, egyezés a korábban
+// használt CRC16 könyvtár algoritmusával, táblázatos vs. slice-by-4 mérés.
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include "test_common.h"
+#include "crc16_ccitt.h"
+
+// A korábbi CRC16 könyvtár (reverseIn = true, reverseOut = true) bitenkénti
+// algoritmusa, bájtról bájtra: bemeneti bájt tükrözés, MSB-first léptetés,
+// a végén 16 bites tükrözés és XOR
+static uint8_t reverse8(uint8_t value) {
+  uint8_t result = 0;
+  for (int bit = 0; bit < 8; bit++) {
+    if (value & (1u << bit)) {
+      result |= (uint8_t)(1u << (7 - bit));
+    }
+  }
+  return result;
+}
+
+static uint16_t reverse16(uint16_t value) {
+  return (uint16_t)((reverse8(value & 0xFF) << 8) | reverse8(value >> 8));
+}
+
+static uint16_t libraryCrc16(uint16_t polynomial, uint16_t initial, uint16_t finalXor,
+                             const uint8_t* data, size_t length) {
+  uint16_t crc = initial;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)(reverse8(data[i]) << 8);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ polynomial) : (uint16_t)(crc << 1);
+    }
+  }
+  return (uint16_t)(reverse16(crc) ^ finalXor);
+}
+
+// A vázlatok beállítása (settings.h: 0x1021, 0xFFFF, 0x0000)
+typedef Crc16Engine<0x1021, 0xFFFF, 0x0000, false> PacketCrcTable;
+typedef Crc16Engine<0x1021, 0xFFFF, 0x0000, true> PacketCrcSlice4;
+// CRC-16/KERMIT: tükrözött CCITT, 0 kezdőérték
+typedef Crc16Engine<0x1021, 0x0000, 0x0000, false> KermitTable;
+typedef Crc16Engine<0x1021, 0x0000, 0x0000, true> KermitSlice4;
+
+int main() {
+  const uint8_t* check = (const uint8_t*)"123456789";
+
+  // Katalógus ellenőrző értékek ("123456789")
+  CHECK(KermitTable::compute(check, 9) == 0x2189);
+  CHECK(KermitSlice4::compute(check, 9) == 0x2189);
+  CHECK(PacketCrcTable::compute(check, 9) == 0x6F91);    // CRC-16/MCRF4XX
+  CHECK(PacketCrcSlice4::compute(check, 9) == 0x6F91);
+  CHECK(libraryCrc16(0x1021, 0x0000, 0x0000, check, 9) == 0x2189);
+  CHECK(libraryCrc16(0x1021, 0xFFFF, 0x0000, check, 9) == 0x6F91);
+
+  // Egyezés a könyvtár algoritmusával: minden hossz 0..64, pszeudovéletlen adat
+  uint8_t buffer[64];
+  uint32_t seed = 1;
+  int mismatches = 0;
+  for (int round = 0; round < 2000; round++) {
+    for (uint8_t& value : buffer) {
+      seed = seed * 1103515245u + 12345u;
+      value = (uint8_t)(seed >> 16);
+    }
+    for (size_t length = 0; length <= sizeof(buffer); length++) {
+      uint16_t expected = libraryCrc16(0x1021, 0xFFFF, 0x0000, buffer, length);
+      mismatches += PacketCrcTable::compute(buffer, length) != expected;
+      mismatches += PacketCrcSlice4::compute(buffer, length) != expected;
+    }
+  }
+  CHECK(mismatches == 0);
+
+  // Minden egybájtos bemenet
+  for (int value = 0; value < 256; value++) {
+    uint8_t single = (uint8_t)value;
+    CHECK(PacketCrcTable::compute(&single, 1) == libraryCrc16(0x1021, 0xFFFF, 0x0000, &single, 1));
+  }
+
+  // Mérés: a v1 csomag CRC-je (5 bájt) és egy 64 bájtos blokk
+  const long iterations = 2000000;
+  for (size_t length : {(size_t)5, (size_t)64}) {
+    double bitwiseNs = benchmarkNs(iterations / 8, [&](long i) {
+      buffer[0] = (uint8_t)i;
+      benchmarkSink += libraryCrc16(0x1021, 0xFFFF, 0x0000, buffer, length);
+    });
+    double tableNs = benchmarkNs(iterations, [&](long i) {
+      buffer[0] = (uint8_t)i;
+      benchmarkSink += PacketCrcTable::compute(buffer, length);
+    });
+    double sliceNs = benchmarkNs(iterations, [&](long i) {
+      buffer[0] = (uint8_t)i;
+      benchmarkSink += PacketCrcSlice4::compute(buffer, length);
+    });
+    std::printf("  %2zu bájt - bitenkénti: %.1f ns | táblázat: %.1f ns | slice-by-4: %.1f ns\n",
+                length, bitwiseNs, tableNs, sliceNs);
+  }
+
+  return testExitCode("test_crc16");
+}
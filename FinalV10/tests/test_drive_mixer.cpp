@@ -0,0 +1,106 @@
+// Differenciál keverő (drive_mixer.h): holtsáv, expo végpontok, telítés,
+// előjel szimmetria, kimerítő tartomány ellenőrzés és hívásonkénti idő.
+#include <cstdint>
+#include <cstdlib>
+#include "test_common.h"
+#include "drive_mixer.h"
+
+// A vázlat alapbeállítása (settings.h: DRIVE_DEADBAND 6, DRIVE_EXPO_PERCENT 30)
+static const MixerConfig DEFAULT_CONFIG = {6, 30};
+static const MixerConfig LINEAR_CONFIG = {0, 0};
+
+static_assert(mixDrive(DRIVE_AXIS_MAX, 0, 255, MixerConfig{6, 30}).left == 255,
+              "Teljes gáz: teljes kitöltés fordítási időben is");
+
+static void testDeadband() {
+  CHECK(shapeDriveAxis(0, DEFAULT_CONFIG) == 0);
+  CHECK(shapeDriveAxis(6, DEFAULT_CONFIG) == 0);
+  CHECK(shapeDriveAxis(-6, DEFAULT_CONFIG) == 0);
+  // A holtsáv szélén nincs ugrás
+  CHECK(shapeDriveAxis(7, DEFAULT_CONFIG) >= 0 && shapeDriveAxis(7, DEFAULT_CONFIG) <= 2);
+  CHECK(!isDriveDeflected(6, -6, DEFAULT_CONFIG));
+  CHECK(isDriveDeflected(7, 0, DEFAULT_CONFIG));
+  CHECK(isDriveDeflected(0, -7, DEFAULT_CONFIG));
+
+  WheelDuty duty = mixDrive(3, -4, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == 0 && duty.right == 0);
+}
+
+static void testExpo() {
+  // Végpontok: teljes kitérés expo mellett is teljes
+  CHECK(shapeDriveAxis(127, DEFAULT_CONFIG) == 127);
+  CHECK(shapeDriveAxis(-127, DEFAULT_CONFIG) == -127);
+  CHECK(shapeDriveAxis(-128, DEFAULT_CONFIG) == -127);
+  CHECK(shapeDriveAxis(127, MixerConfig{6, 100}) == 127);
+  // Középen finomabb, mint a lineáris
+  CHECK(shapeDriveAxis(64, LINEAR_CONFIG) == 64);
+  CHECK(shapeDriveAxis(64, DEFAULT_CONFIG) < shapeDriveAxis(64, LINEAR_CONFIG));
+
+  int monotonicFailures = 0;
+  int symmetryFailures = 0;
+  for (int value = -128; value < 127; value++) {
+    monotonicFailures += shapeDriveAxis(value, DEFAULT_CONFIG) > shapeDriveAxis(value + 1, DEFAULT_CONFIG);
+  }
+  for (int value = -127; value <= 127; value++) {
+    symmetryFailures += shapeDriveAxis(value, DEFAULT_CONFIG) != -shapeDriveAxis(-value, DEFAULT_CONFIG);
+  }
+  CHECK(monotonicFailures == 0);
+  CHECK(symmetryFailures == 0);
+}
+
+static void testSaturation() {
+  WheelDuty duty = mixDrive(127, 0, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == 255 && duty.right == 255);
+  duty = mixDrive(-127, 0, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == -255 && duty.right == -255);
+  // Helyben fordulás
+  duty = mixDrive(0, 127, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == 255 && duty.right == -255);
+  // Teljes gáz + teljes kormány: a külső kerék a skála szélén, a belső áll
+  duty = mixDrive(127, 127, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == 255 && duty.right == 0);
+  duty = mixDrive(-127, -127, 255, DEFAULT_CONFIG);
+  CHECK(duty.left == -255 && duty.right == 0);
+  // Telítésnél az arány megmarad (a kanyar íve nem torzul)
+  duty = mixDrive(127, 64, 200, LINEAR_CONFIG);
+  CHECK(duty.left == 200 && duty.right == 63 * 200 / 191);
+}
+
+// Kimerítő: minden (gáz, kormány) pár a tartományban marad, a kormány
+// tükrözése felcseréli, a gázé negálja a kerekeket
+static void testExhaustiveSymmetry() {
+  int rangeFailures = 0;
+  int steerMirrorFailures = 0;
+  int throttleMirrorFailures = 0;
+  for (int throttle = -127; throttle <= 127; throttle++) {
+    for (int steer = -127; steer <= 127; steer++) {
+      WheelDuty duty = mixDrive((int8_t)throttle, (int8_t)steer, 255, DEFAULT_CONFIG);
+      rangeFailures += std::abs(duty.left) > 255 || std::abs(duty.right) > 255;
+
+      WheelDuty steerMirror = mixDrive((int8_t)throttle, (int8_t)-steer, 255, DEFAULT_CONFIG);
+      steerMirrorFailures += steerMirror.left != duty.right || steerMirror.right != duty.left;
+
+      WheelDuty reversed = mixDrive((int8_t)-throttle, (int8_t)-steer, 255, DEFAULT_CONFIG);
+      throttleMirrorFailures += reversed.left != -duty.left || reversed.right != -duty.right;
+    }
+  }
+  CHECK(rangeFailures == 0);
+  CHECK(steerMirrorFailures == 0);
+  CHECK(throttleMirrorFailures == 0);
+}
+
+int main() {
+  testDeadband();
+  testExpo();
+  testSaturation();
+  testExhaustiveSymmetry();
+
+  // A vezérlési ütemben hívásonként egyszer fut
+  double mixNs = benchmarkNs(20000000, [](long i) {
+    WheelDuty duty = mixDrive((int8_t)(i >> 8), (int8_t)i, 255, DEFAULT_CONFIG);
+    benchmarkSink += (unsigned long)(duty.left - duty.right);
+  });
+  std::printf("  mixDrive: %.2f ns/hívás\n", mixNs);
+
+  return testExitCode("test_drive_mixer");
+}
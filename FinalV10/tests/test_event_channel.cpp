@@ -0,0 +1,116 @@
+// Sebesség váltás események (event_channel.h) csomagvesztés mellett: a v1
+// (8 bites) és a v2 (3 bites, packet_v2.h) számlálóval minden gombnyomás
+// pontosan egyszer hajtódik végre, akkor is, ha egy kiesésbe több esik.
+#include <cstdlib>
+#include "test_common.h"
+#include "packet_v2.h"
+#include "lora_phy_profile.h"
+#include "event_channel.h"
+
+static const uint8_t ROBOT = 69;
+
+// v2 kódolás → dekódolás, ahogy a csomag a levegőn utazik
+static uint8_t v2RoundTrip(uint8_t count, uint8_t sequence) {
+  PacketV2 sent = { 0x01, false, false, sequence, (uint8_t)(count & PACKET_V2_EVENT_MASK), 0 };
+  uint8_t frame[PACKET_V2_SIZE];
+  encodePacketV2(sent, ROBOT, frame);
+  PacketV2 received;
+  CHECK(decodePacketV2(frame, ROBOT, received) == PACKET_V2_OK);
+  CHECK(received.sequence == sequence);
+  return received.speedEventCount;
+}
+
+// Egy kiesésbe eső presses gombnyomás: a kiesés utáni első csomag pótolja mindet
+static void testPressesDuringOutage(bool v2) {
+  const uint8_t mask = v2 ? PACKET_V2_EVENT_MASK : 0xFF;
+  for (int presses = 1; presses <= PACKET_V2_EVENT_MASK; presses++) {
+    EventReconciler reconciler;
+    uint8_t count = 0;
+    uint8_t sequence = 0;
+    unsigned long timeMs = 0;
+    uint32_t applied = 0;
+
+    // Alapérték, majd a kiesés alatt elveszett csomagok (mindegyikben egy gombnyomás)
+    reconciler.reconcile(count, mask, sequence++, timeMs);
+    for (int i = 0; i < presses; i++) {
+      count++;
+      sequence++;
+      timeMs += 30;
+    }
+    uint8_t wireCount = v2 ? v2RoundTrip(count, sequence) : count;
+    applied += reconciler.reconcile(wireCount, mask, sequence++, timeMs += 30);
+
+    // Ismétlés (azonos sorszám) nem hajtja végre újra
+    applied += reconciler.reconcile(wireCount, mask, sequence - 1, timeMs += 10);
+    CHECK(applied == (uint32_t)presses);
+  }
+}
+
+// Véletlen veszteség (30%) és gombnyomások: a végrehajtott összeg = a megnyomott
+static void testRandomLoss() {
+  std::srand(4242);
+  EventReconciler reconciler;
+  uint8_t count = 0;
+  uint8_t sequence = 0;
+  unsigned long timeMs = 0;
+  uint32_t pressed = 0;
+  uint32_t applied = 0;
+  int pendingPresses = 0;
+
+  reconciler.reconcile(v2RoundTrip(count, sequence), PACKET_V2_EVENT_MASK, sequence, timeMs);
+  for (int i = 0; i < 20000; i++) {
+    // Egy kiesésben legfeljebb 7 gombnyomás (a 3 bites számláló határa)
+    if (std::rand() % 4 == 0 && pendingPresses < PACKET_V2_EVENT_MASK) {
+      count++;
+      pressed++;
+      pendingPresses++;
+    }
+    sequence++;
+    timeMs += 36;
+    bool lost = std::rand() % 10 < 3 && pendingPresses < PACKET_V2_EVENT_MASK;
+    if (!lost) {
+      applied += reconciler.reconcile(v2RoundTrip(count, sequence), PACKET_V2_EVENT_MASK, sequence, timeMs);
+      pendingPresses = 0;
+    }
+  }
+  sequence++;
+  applied += reconciler.reconcile(v2RoundTrip(count, sequence), PACKET_V2_EVENT_MASK, sequence, timeMs + 36);
+  std::printf("  v2, 30%% vesztés: %lu gombnyomás, %lu végrehajtva, %lu pótolva\n", (unsigned long)pressed,
+              (unsigned long)applied, (unsigned long)reconciler.getRecoveredEvents());
+  CHECK(applied == pressed);
+}
+
+// A példány sorszám (2. bájt [4:3]) a számlálót és a parancsot nem zavarja
+static void testV2CopyIndex() {
+  for (uint8_t copy = 0; copy <= PACKET_V2_COPY_MASK; copy++) {
+    PacketV2 sent = { 0x05, false, true, 200, 6, copy };
+    uint8_t frame[PACKET_V2_SIZE];
+    encodePacketV2(sent, ROBOT, frame);
+    CHECK((frame[2] & 0x07) == 0);             // Tartalék bitek
+    PacketV2 received;
+    CHECK(decodePacketV2(frame, ROBOT, received) == PACKET_V2_OK);
+    CHECK(received.copyIndex == copy);
+    CHECK(received.speedEventCount == 6);
+    CHECK(received.command == 0x05 && received.landingFlag && received.sequence == 200);
+  }
+}
+
+// A negyedik bájt nem növeli a légidőt (implicit fejléc, egy blokk)
+static void testV2Airtime() {
+  for (int p = 0; p < LORA_PROFILE_COUNT; p++) {
+    const LoRaPhyProfile& profile = loraPhyProfile((LoRaPhyProfileId)p);
+    std::printf("  v2 légidő: 3 bájt %lu µs | 4 bájt %lu µs | %s\n",
+                (unsigned long)loraTimeOnAirUs(profile, 3, true),
+                (unsigned long)loraTimeOnAirUs(profile, PACKET_V2_SIZE, true), profile.name);
+    CHECK(loraTimeOnAirUs(profile, PACKET_V2_SIZE, true) == loraTimeOnAirUs(profile, 3, true));
+  }
+}
+
+int main() {
+  testPressesDuringOutage(false);
+  testPressesDuringOutage(true);
+  testRandomLoss();
+  testV2CopyIndex();
+  testV2Airtime();
+  return testExitCode("test_event_channel");
+}
@@ -0,0 +1,149 @@
+// Kétlépcsős failsafe (failsafe.h) a vezérlési ütemen: gyors változás
+// sorozat (arányos kar, ~36 ms csomagköz) után a kar elengedésekor csak
+// életjelek jönnek (100 ms + ismétlés szünet + légidő) - ez nem indíthat
+// lejtőt. Valódi kiesésnél a leállás legkésőbb FAILSAFE_TIMEOUT_MS-nél jön.
+#include <initializer_list>
+#include "test_common.h"
+#include "failsafe.h"
+
+static const unsigned long TICK_MS = 1000 / CONTROL_TICK_HZ;
+static const int BURST_PACKETS = 28;           // 1 s kar mozgatás 36 ms-enként
+
+struct RunResult {
+  int rampTicks;
+  int stopTicks;
+  unsigned long firstRampMs;
+  unsigned long firstStopMs;
+};
+
+// A beavatkozó task: ütemenként a beérkezett csomagok után reset, különben check
+class ControlLoop {
+private:
+  Failsafe& failsafe;
+  const unsigned long* arrivals;
+  int count;
+  int next;
+  unsigned long timeMs;
+
+public:
+  ControlLoop(Failsafe& failsafe, const unsigned long* arrivals, int count)
+    : failsafe(failsafe), arrivals(arrivals), count(count), next(0), timeMs(0) {}
+
+  // A vezérlési ütem futtatása untilMs-ig (az addig érkezett csomagokkal)
+  RunResult runUntil(unsigned long untilMs) {
+    RunResult result = {0, 0, 0, 0};
+    for (; timeMs + TICK_MS <= untilMs;) {
+      timeMs += TICK_MS;
+      stubMillis = timeMs;
+      bool packetProcessed = false;
+      while (next < count && arrivals[next] <= timeMs) {
+        next++;
+        packetProcessed = true;
+      }
+      if (packetProcessed) {
+        failsafe.setActiveProfile(LORA_PHY_PROFILE);
+        failsafe.reset();
+        continue;
+      }
+      switch (failsafe.check()) {
+        case FAILSAFE_RAMP:
+          result.firstRampMs = result.rampTicks++ ? result.firstRampMs : timeMs;
+          break;
+        case FAILSAFE_STOP:
+          result.firstStopMs = result.stopTicks++ ? result.firstStopMs : timeMs;
+          break;
+        case FAILSAFE_HOLD:
+          break;
+      }
+    }
+    return result;
+  }
+};
+
+// Kar mozgatás (változás csomag 36 ms-enként), utána 10 életjel keepaliveGapMs
+// csomagközzel. Visszatér: a csomagok száma.
+static int burstThenKeepalives(unsigned long* arrivals, unsigned long keepaliveGapMs) {
+  int count = 0;
+  unsigned long timeMs = 20;
+  for (; count < BURST_PACKETS; timeMs += 36) {
+    arrivals[count++] = timeMs;
+  }
+  timeMs = arrivals[count - 1];
+  for (int i = 0; i < 10; i++) {
+    timeMs += keepaliveGapMs;
+    arrivals[count++] = timeMs;
+  }
+  return count;
+}
+
+static void testBurstThenKeepalive() {
+  const unsigned long worstGapMs = failsafeKeepaliveGapMs(LORA_PHY_PROFILE) - TICK_MS;
+  std::printf("  életjel köz (ms) | tartás a sorozat végén (ms) | lejtő ütem | leállás ütem\n");
+  for (unsigned long gapMs : {(unsigned long)REMOTE_KEEPALIVE_INTERVAL_MS, 120UL, worstGapMs}) {
+    stubMillis = 0;
+    Failsafe failsafe;
+    failsafe.init();
+
+    unsigned long arrivals[64];
+    int count = burstThenKeepalives(arrivals, gapMs);
+
+    // A sorozat végén a mért átlag lecsökkent, a tartás mégsem rövidebb az életjel köznél
+    ControlLoop loop(failsafe, arrivals, count);
+    loop.runUntil(arrivals[BURST_PACKETS - 1] + TICK_MS);
+    uint32_t holdAfterBurstMs = failsafe.getHoldWindowMs();
+    CHECK(holdAfterBurstMs >= failsafeKeepaliveGapMs(LORA_PHY_PROFILE));
+
+    RunResult result = loop.runUntil(arrivals[count - 1] + TICK_MS);
+    std::printf("  %16lu | %27lu | %10d | %12d\n", gapMs, (unsigned long)holdAfterBurstMs,
+                result.rampTicks, result.stopTicks);
+    CHECK(result.rampTicks == 0);
+    CHECK(result.stopTicks == 0);
+    CHECK(!failsafe.isRamping());
+    CHECK(failsafe.getBridgedGapCount() == 0);
+  }
+}
+
+// Valódi kiesés: lejtő a tartás után, leállás legkésőbb FAILSAFE_TIMEOUT_MS-nél
+static void testOutageStillStops() {
+  stubMillis = 0;
+  Failsafe failsafe;
+  failsafe.init();
+
+  unsigned long arrivals[64];
+  int count = burstThenKeepalives(arrivals, REMOTE_KEEPALIVE_INTERVAL_MS);
+  unsigned long lastMs = arrivals[count - 1];
+  ControlLoop loop(failsafe, arrivals, count);
+  RunResult result = loop.runUntil(lastMs + 2 * FAILSAFE_TIMEOUT_MS);
+
+  std::printf("  kiesés: lejtő %lu ms, leállás %lu ms után (tartás: %lu ms)\n",
+              result.firstRampMs - lastMs, result.firstStopMs - lastMs,
+              (unsigned long)failsafe.getHoldWindowMs());
+  CHECK(result.rampTicks > 0);
+  CHECK(result.firstRampMs - lastMs > failsafeKeepaliveGapMs(LORA_PHY_PROFILE));
+  CHECK(result.stopTicks > 0);
+  CHECK(result.firstStopMs - lastMs <= FAILSAFE_TIMEOUT_MS + TICK_MS);   // + ütem felbontás
+  CHECK(failsafe.isActive());
+}
+
+// A tartás alsó korlátja profilonként (a légidő benne van), legfeljebb TIMEOUT - RAMP
+static void testProfileFloor() {
+  Failsafe failsafe;
+  uint32_t previousFloorMs = 0;
+  for (int p = 0; p < LORA_PROFILE_COUNT; p++) {
+    failsafe.setActiveProfile((LoRaPhyProfileId)p);
+    uint32_t holdMs = failsafe.getHoldWindowMs();
+    std::printf("  életjel köz: %3lu ms | tartás: %3lu ms | %s\n",
+                (unsigned long)failsafeKeepaliveGapMs((LoRaPhyProfileId)p), (unsigned long)holdMs,
+                LORA_PHY_PROFILES[p].name);
+    CHECK(holdMs >= previousFloorMs);
+    CHECK(holdMs + FAILSAFE_RAMP_MS <= FAILSAFE_TIMEOUT_MS);
+    previousFloorMs = holdMs;
+  }
+}
+
+int main() {
+  testBurstThenKeepalive();
+  testOutageStillStops();
+  testProfileFloor();
+  return testExitCode("test_failsafe");
+}
@@ -0,0 +1,128 @@
+// Gomb parancs → kitöltés táblázat (motor_command_table.h): egyezés a korábbi
+// futásidejű (fokozat tömb + négy logikai irány) végrehajtással, és a két
+// változat parancsonkénti ideje. A kerék cél írása mindkét esetben ugyanaz a
+// nem inline-olt nyelő, így csak a parancs dekódolás különbsége mérődik.
+#include <cstdint>
+#include <initializer_list>
+#include "test_common.h"
+#include "motor_command_table.h"
+
+// A vázlat fokozatai (settings.h: SPEED_LEVEL_1..3)
+#define TEST_SPEED_LEVELS 255, 120, 40
+static const int LEVEL_COUNT = 3;
+
+static volatile int sinkLeft;
+static volatile int sinkRight;
+
+__attribute__((noinline)) static void setWheelTargets(int leftTarget, int rightTarget) {
+  sinkLeft = leftTarget;
+  sinkRight = rightTarget;
+}
+
+__attribute__((noinline)) static void stopMotors() {
+  setWheelTargets(0, 0);
+}
+
+// A sablon előtti MotorControl parancs útja (futásidejű fokozat tömb)
+struct RuntimeDispatch {
+  int speedLevels[LEVEL_COUNT] = {TEST_SPEED_LEVELS};
+  int currentSpeedLevelIndex = 0;
+
+  bool validateCommand(uint8_t motorCommand) {
+    bool leftConflict = (motorCommand & 0b0001) && (motorCommand & 0b0010);
+    bool rightConflict = (motorCommand & 0b0100) && (motorCommand & 0b1000);
+    return !leftConflict && !rightConflict;
+  }
+
+  void control(bool leftForward, bool leftBackward, bool rightForward, bool rightBackward,
+               uint16_t outputScale) {
+    int currentSpeed = (speedLevels[currentSpeedLevelIndex] * outputScale) >> 8;
+    setWheelTargets(leftForward ? currentSpeed : (leftBackward ? -currentSpeed : 0),
+                    rightForward ? currentSpeed : (rightBackward ? -currentSpeed : 0));
+  }
+
+  void executeCommand(uint8_t motorCommand, uint16_t outputScale = 256) {
+    if (!validateCommand(motorCommand)) {
+      stopMotors();
+      return;
+    }
+    if (motorCommand == 0) {
+      stopMotors();
+    } else {
+      control(motorCommand & 0b0001, motorCommand & 0b0010, motorCommand & 0b0100, motorCommand & 0b1000,
+              outputScale);
+    }
+  }
+};
+
+// A MotorControl<PinSet, SpeedLevels...>::executeCommand útja
+struct TableDispatch {
+  static constexpr CommandTable<LEVEL_COUNT> COMMAND_TABLE = buildCommandTable<TEST_SPEED_LEVELS>();
+  int currentSpeedLevelIndex = 0;
+
+  void executeCommand(uint8_t motorCommand, uint16_t outputScale = 256) {
+    const CommandDuty& duty = COMMAND_TABLE.entries[currentSpeedLevelIndex][motorCommand & 0x0F];
+    if (!duty.valid) {
+      stopMotors();
+      return;
+    }
+    if (motorCommand == 0) {
+      stopMotors();
+    } else if (outputScale == 256) {
+      setWheelTargets(duty.left, duty.right);
+    } else {
+      setWheelTargets(duty.left * outputScale / 256, duty.right * outputScale / 256);
+    }
+  }
+};
+
+static constexpr int SPEEDS[LEVEL_COUNT] = {TEST_SPEED_LEVELS};
+static_assert(commandTableConsistent(TableDispatch::COMMAND_TABLE, SPEEDS),
+              "A parancs táblázat eltér a bitek jelentésétől");
+
+int main() {
+  RuntimeDispatch runtime;
+  TableDispatch table;
+
+  // Minden fokozat, minden 4 bites parancs, teljes és failsafe lejtő skálák
+  int mismatches = 0;
+  for (int level = 0; level < LEVEL_COUNT; level++) {
+    runtime.currentSpeedLevelIndex = table.currentSpeedLevelIndex = level;
+    for (int command = 0; command < MOTOR_COMMAND_COUNT; command++) {
+      for (int scale : {256, 200, 129, 1, 0}) {
+        runtime.executeCommand((uint8_t)command, (uint16_t)scale);
+        int expectedLeft = sinkLeft;
+        int expectedRight = sinkRight;
+        table.executeCommand((uint8_t)command, (uint16_t)scale);
+        mismatches += sinkLeft != expectedLeft || sinkRight != expectedRight;
+      }
+    }
+  }
+  CHECK(mismatches == 0);
+
+  // Érvénytelen kombinációk: fokozatonként 7, mind álló
+  for (int command = 0; command < MOTOR_COMMAND_COUNT; command++) {
+    CHECK(TableDispatch::COMMAND_TABLE.entries[0][command].valid == isValidMotorCommand(command));
+  }
+
+  // Véletlen parancs sorozat, fokozatváltással
+  uint8_t commands[4096];
+  uint32_t seed = 12345;
+  for (uint8_t& command : commands) {
+    seed = seed * 1103515245u + 12345u;
+    command = (uint8_t)((seed >> 16) & 0x0F);
+  }
+  const long iterations = 40000000;
+  double runtimeNs = benchmarkNs(iterations, [&](long i) {
+    runtime.currentSpeedLevelIndex = (int)((i >> 12) % LEVEL_COUNT);
+    runtime.executeCommand(commands[i & 4095]);
+  });
+  double tableNs = benchmarkNs(iterations, [&](long i) {
+    table.currentSpeedLevelIndex = (int)((i >> 12) % LEVEL_COUNT);
+    table.executeCommand(commands[i & 4095]);
+  });
+  std::printf("  executeCommand - futásidejű: %.2f ns | táblázat: %.2f ns (%.2fx)\n",
+              runtimeNs, tableNs, runtimeNs / tableNs);
+
+  return testExitCode("test_motor_command_table");
+}
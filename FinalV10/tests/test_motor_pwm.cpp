@@ -0,0 +1,261 @@
+// MCPWM H-híd háttér (motor_pwm.h) árnyék regiszteres MCPWM modellen: a
+// write() csak előkészít, a négy kimenet egyetlen szoftveres szinkronnal
+// együtt töltődik be; irányváltáskor (rámpa nélkül is) előbb mindkét ág
+// alacsony, legalább MCPWM_DEAD_TIME_NS-ig, és egy híd két ága soha nem aktív.
+#include <cstdlib>
+#include "test_common.h"
+#include "settings.h"
+
+// A vázlat alapból LEDC-t fordít: itt az MCPWM hátteret mérjük
+#undef MOTOR_PWM_MCPWM
+#define MOTOR_PWM_MCPWM true
+#include "motor_pwm.h"
+
+// ═════════════════════════════════════════════════════════
+// MCPWM MODELL: árnyék + aktív regiszter, betöltés a szinkronnál
+// ═════════════════════════════════════════════════════════
+struct ComparatorModel {
+  bool loadOnSync;
+  uint32_t shadowTicks;
+  uint32_t activeTicks;
+};
+
+struct GeneratorModel {
+  bool loadOnSync;
+  int pin;
+  ComparatorModel* comparator;
+  bool shadowHigh;             // Periódus eleji akció
+  bool activeHigh;
+};
+
+struct PwmModel {
+  ComparatorModel comparators[4];
+  GeneratorModel generators[4];
+  bool operatorLoadOnSync[2];
+  int comparatorCount;
+  int generatorCount;
+  int operatorCount;
+  bool phaseOnSync;
+  bool running;
+
+  // Betöltésenként (szinkron): a kimenetek aktív kitöltése és az idő (µs)
+  int loadCount;
+  uint32_t loadedTicks[64][4];
+  unsigned long loadedAtUs[64];
+};
+
+static PwmModel model;
+
+static uint32_t outputTicks(const GeneratorModel& generator) {
+  return generator.activeHigh ? generator.comparator->activeTicks : 0;
+}
+
+esp_err_t mcpwm_new_timer(const mcpwm_timer_config_t*, mcpwm_timer_handle_t* timer) {
+  *timer = (mcpwm_timer_handle_t)&model;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_operator(const mcpwm_operator_config_t* config, mcpwm_oper_handle_t* oper) {
+  model.operatorLoadOnSync[model.operatorCount] = config->flags.update_gen_action_on_sync;
+  *oper = (mcpwm_oper_handle_t)&model.operatorLoadOnSync[model.operatorCount++];
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_operator_connect_timer(mcpwm_oper_handle_t, mcpwm_timer_handle_t) {
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_comparator(mcpwm_oper_handle_t, const mcpwm_comparator_config_t* config,
+                               mcpwm_cmpr_handle_t* comparator) {
+  ComparatorModel& created = model.comparators[model.comparatorCount++];
+  created.loadOnSync = config->flags.update_cmp_on_sync && !config->flags.update_cmp_on_tez;
+  *comparator = (mcpwm_cmpr_handle_t)&created;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_generator(mcpwm_oper_handle_t oper, const mcpwm_generator_config_t* config,
+                              mcpwm_gen_handle_t* generator) {
+  GeneratorModel& created = model.generators[model.generatorCount];
+  created.loadOnSync = *(bool*)oper;
+  created.pin = config->gen_gpio_num;
+  created.comparator = &model.comparators[model.generatorCount++];
+  *generator = (mcpwm_gen_handle_t)&created;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_generator_set_action_on_timer_event(mcpwm_gen_handle_t generator, mcpwm_gen_timer_event_action_t action) {
+  GeneratorModel* target = (GeneratorModel*)generator;
+  target->shadowHigh = action.action == MCPWM_GEN_ACTION_HIGH;
+  if (!model.running) {
+    target->activeHigh = target->shadowHigh;
+  }
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_generator_set_action_on_compare_event(mcpwm_gen_handle_t, mcpwm_gen_compare_event_action_t) {
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_comparator_set_compare_value(mcpwm_cmpr_handle_t comparator, uint32_t ticks) {
+  ComparatorModel* target = (ComparatorModel*)comparator;
+  target->shadowTicks = ticks;
+  if (!model.running) {
+    target->activeTicks = ticks;
+  }
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_new_soft_sync_src(const mcpwm_soft_sync_config_t*, mcpwm_sync_handle_t* sync) {
+  *sync = (mcpwm_sync_handle_t)&model;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_timer_set_phase_on_sync(mcpwm_timer_handle_t, const mcpwm_timer_sync_phase_config_t* config) {
+  model.phaseOnSync = config->sync_src != nullptr && config->count_value == 0;
+  return ESP_OK;
+}
+
+// Szinkron: minden szinkronra állított árnyék regiszter egyszerre töltődik be
+esp_err_t mcpwm_soft_sync_activate(mcpwm_sync_handle_t) {
+  for (int i = 0; i < 4; i++) {
+    if (model.comparators[i].loadOnSync) {
+      model.comparators[i].activeTicks = model.comparators[i].shadowTicks;
+    }
+    if (model.generators[i].loadOnSync) {
+      model.generators[i].activeHigh = model.generators[i].shadowHigh;
+    }
+  }
+  if (model.loadCount < 64) {
+    for (int i = 0; i < 4; i++) {
+      model.loadedTicks[model.loadCount][i] = outputTicks(model.generators[i]);
+    }
+    model.loadedAtUs[model.loadCount] = stubMicros;
+  }
+  model.loadCount++;
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_timer_enable(mcpwm_timer_handle_t) {
+  return ESP_OK;
+}
+
+esp_err_t mcpwm_timer_start_stop(mcpwm_timer_handle_t, mcpwm_timer_start_stop_cmd_t) {
+  model.running = true;
+  return ESP_OK;
+}
+
+// ═════════════════════════════════════════════════════════
+// TESZTEK
+// ═════════════════════════════════════════════════════════
+static const uint32_t PERIOD_TICKS = MCPWM_RESOLUTION_HZ / MCPWM_FREQUENCY;
+
+static uint32_t ticksFor(int duty) {
+  return (uint32_t)duty * PERIOD_TICKS / MOTOR_PWM_FULL_SCALE;
+}
+
+static void startModel(McpwmBridgePwm<RobotMotorPins>& pwm) {
+  model = PwmModel();
+  stubMicros = 0;
+  CHECK(pwm.init());
+  CHECK(model.phaseOnSync);
+  for (int i = 0; i < 4; i++) {
+    CHECK(model.comparators[i].loadOnSync);
+    CHECK(model.generators[i].loadOnSync);
+  }
+  CHECK(model.generators[0].pin == LEFT_MOTOR_FORWARD_PIN);
+  CHECK(model.generators[3].pin == RIGHT_MOTOR_REVERSE_PIN);
+}
+
+// A write() előkészít, a négy kimenet egyetlen szinkronnal vált
+static void testAtomicUpdate() {
+  McpwmBridgePwm<RobotMotorPins> pwm;
+  startModel(pwm);
+
+  pwm.write(200, -100);
+  CHECK(model.loadCount == 1);
+  CHECK(model.loadedTicks[0][0] == ticksFor(200));
+  CHECK(model.loadedTicks[0][1] == 0);
+  CHECK(model.loadedTicks[0][2] == 0);
+  CHECK(model.loadedTicks[0][3] == ticksFor(100));
+
+  // Változatlan parancs: nincs szinkron (nem rövidít periódust)
+  pwm.write(200, -100);
+  CHECK(model.loadCount == 1);
+
+  // Mindkét oldal változik: továbbra is egy betöltés
+  pwm.write(120, -40);
+  CHECK(model.loadCount == 2);
+  CHECK(model.loadedTicks[1][0] == ticksFor(120));
+  CHECK(model.loadedTicks[1][3] == ticksFor(40));
+}
+
+// Irányváltás rámpa nélkül (+duty → -duty): előbb nulla, holtidő, utána az új irány
+static void testReversalDeadTime() {
+  McpwmBridgePwm<RobotMotorPins> pwm;
+  startModel(pwm);
+
+  pwm.write(255, 100);
+  int before = model.loadCount;
+  pwm.write(-255, 100);
+  CHECK(model.loadCount == before + 2);
+
+  const uint32_t* zero = model.loadedTicks[before];
+  const uint32_t* reversed = model.loadedTicks[before + 1];
+  CHECK(zero[0] == 0 && zero[1] == 0);
+  CHECK(zero[2] == ticksFor(100));                 // A másik híd nem áll meg
+  CHECK(reversed[0] == 0 && reversed[1] == ticksFor(255));
+  unsigned long deadUs = model.loadedAtUs[before + 1] - model.loadedAtUs[before];
+  std::printf("  irányváltás: nulla → új irány %lu µs (MCPWM_DEAD_TIME_NS: %d)\n", deadUs, MCPWM_DEAD_TIME_NS);
+  CHECK(deadUs * 1000 >= MCPWM_DEAD_TIME_NS);
+
+  // Nullán át (rámpa) nincs külön várakozás
+  pwm.write(0, 100);
+  before = model.loadCount;
+  unsigned long startUs = stubMicros;
+  pwm.write(50, 100);
+  CHECK(model.loadCount == before + 1);
+  CHECK(stubMicros == startUs);
+}
+
+// Véletlen előjeles parancsok (kerék PID / rámpa nélkül): egy híd két ága soha
+// nem aktív egyszerre, és minden irányváltás előtt van holtidős nulla állapot
+static void testRandomCommands() {
+  McpwmBridgePwm<RobotMotorPins> pwm;
+  startModel(pwm);
+  std::srand(1234);
+
+  bool bothLegsActive = false;
+  bool reversalWithoutDeadTime = false;
+  int sign[2] = {0, 0};
+  int reversals = 0;
+  for (int step = 0; step < 5000; step++) {
+    int before = model.loadCount;
+    pwm.write(std::rand() % 511 - 255, std::rand() % 511 - 255);
+    // Több betöltés egy write()-on belül csak irányváltásnál, holtidővel
+    if (model.loadCount - before > 1) {
+      reversals++;
+      reversalWithoutDeadTime |= (model.loadedAtUs[before + 1] - model.loadedAtUs[before]) * 1000 < MCPWM_DEAD_TIME_NS;
+    }
+    for (int load = before; load < model.loadCount; load++) {
+      for (int bridge = 0; bridge < 2; bridge++) {
+        uint32_t forward = model.loadedTicks[load][2 * bridge];
+        uint32_t reverse = model.loadedTicks[load][2 * bridge + 1];
+        bothLegsActive |= forward && reverse;
+        int loadedSign = forward ? 1 : (reverse ? -1 : 0);
+        reversalWithoutDeadTime |= loadedSign != 0 && sign[bridge] == -loadedSign;
+        sign[bridge] = loadedSign;
+      }
+    }
+    model.loadCount = 0;
+  }
+  std::printf("  véletlen parancsok: 5000 írás, %d irányváltás holtidővel\n", reversals);
+  CHECK(!bothLegsActive);
+  CHECK(!reversalWithoutDeadTime);
+}
+
+int main() {
+  testAtomicUpdate();
+  testReversalDeadTime();
+  testRandomCommands();
+  return testExitCode("test_motor_pwm");
+}
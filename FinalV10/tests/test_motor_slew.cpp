@@ -0,0 +1,99 @@
+// Kitöltés meredekség korlátozó (motor_slew.h) a vezérlési ütemen: a
+// 0 → +255 → -255 → 0 parancs sorozat (alap rámpák, CONTROL_TICK_HZ), ütemenkénti
+// legnagyobb ugrás, fékezés nullán át, rámpa idők és az azonnali leállítás.
+#include <cstdlib>
+#include "test_common.h"
+#include "settings.h"
+#include "motor_slew.h"
+
+// Alap rámpák (settings.h): emelkedés SPEED_LEVEL_1_RAMP_MS, fékezés MOTOR_BRAKE_RAMP_MS
+static const int TICK_MS = 1000 / CONTROL_TICK_HZ;
+
+static const int32_t RISE_STEP = slewStepQ8(255, SPEED_LEVEL_1_RAMP_MS, CONTROL_TICK_HZ);
+static const int32_t FALL_STEP = slewStepQ8(255, MOTOR_BRAKE_RAMP_MS, CONTROL_TICK_HZ);
+
+static int commandAt(int timeMs) {
+  return timeMs < 50 ? 0 : (timeMs < 600 ? 255 : (timeMs < 1000 ? -255 : 0));
+}
+
+// Ennyi ütem kell a célig (az aktuális állapotból)
+static int ticksToSettle(SlewLimiter& slew, int target) {
+  slew.setTarget(target);
+  int ticks = 0;
+  while (!slew.isSettled() && ticks < 10000) {
+    slew.step(RISE_STEP, FALL_STEP);
+    ticks++;
+  }
+  return ticks;
+}
+
+static void testCommandSequence() {
+  SlewLimiter slew;
+  int largestStep = 0;
+  int previous = 0;
+  bool signFlipWithoutZero = false;
+
+  std::printf("  idő (ms) | parancs | kitöltés  (c = parancs, # = kitöltés)\n");
+  for (int timeMs = 0; timeMs < 1400; timeMs += TICK_MS) {
+    int command = commandAt(timeMs);
+    slew.setTarget(command);
+    int duty = slew.step(RISE_STEP, FALL_STEP);
+    signFlipWithoutZero |= (previous > 0 && duty < 0) || (previous < 0 && duty > 0);
+    largestStep = std::abs(duty - previous) > largestStep ? std::abs(duty - previous) : largestStep;
+    previous = duty;
+
+    if (timeMs % 50 == 0) {
+      char plot[62];
+      for (int i = 0; i < 61; i++) {
+        plot[i] = ' ';
+      }
+      plot[61] = 0;
+      plot[30] = '|';
+      plot[(command + 255) * 30 / 255] = 'c';
+      plot[(duty + 255) * 30 / 255] = '#';
+      std::printf("  %8d | %7d | %5d %s\n", timeMs, command, duty, plot);
+    }
+  }
+
+  // Fékezés: 255 / (150 ms * 200 Hz) → legfeljebb 9 kitöltés / ütem (korábban 255, irányváltáskor 510)
+  std::printf("  legnagyobb ugrás: %d / ütem\n", largestStep);
+  CHECK(largestStep <= 9);
+  CHECK(!signFlipWithoutZero);
+  CHECK(previous == 0);
+}
+
+static void testRampTimes() {
+  SlewLimiter slew;
+  int riseTicks = ticksToSettle(slew, 255);
+  CHECK(std::abs(riseTicks * TICK_MS - SPEED_LEVEL_1_RAMP_MS) <= TICK_MS);
+
+  // Irányváltás: fékezés nulláig, majd gyorsítás a másik irányba
+  int reverseTicks = ticksToSettle(slew, -255);
+  CHECK(std::abs(reverseTicks * TICK_MS - (MOTOR_BRAKE_RAMP_MS + SPEED_LEVEL_1_RAMP_MS)) <= 2 * TICK_MS);
+
+  int brakeTicks = ticksToSettle(slew, 0);
+  CHECK(std::abs(brakeTicks * TICK_MS - MOTOR_BRAKE_RAMP_MS) <= TICK_MS);
+
+  // 0 ms rámpa: azonnali ugrás (MOTOR_SLEW_ENABLED = false viselkedés)
+  slew.setTarget(200);
+  CHECK(slew.step(slewStepQ8(255, 0, CONTROL_TICK_HZ), slewStepQ8(255, 0, CONTROL_TICK_HZ)) == 200);
+}
+
+// A failsafe leállás (MotorControl::hardStop) nem vár a fékezési rámpára
+static void testHardStop() {
+  SlewLimiter slew;
+  ticksToSettle(slew, 255);
+  slew.setTarget(0);
+  CHECK(slew.step(RISE_STEP, FALL_STEP) > 0);      // Rámpával még jár
+  slew.reset();
+  CHECK(slew.getDuty() == 0);
+  CHECK(slew.isSettled());
+  CHECK(slew.step(RISE_STEP, FALL_STEP) == 0);
+}
+
+int main() {
+  testCommandSequence();
+  testRampTimes();
+  testHardStop();
+  return testExitCode("test_motor_slew");
+}
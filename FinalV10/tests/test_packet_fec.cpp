@@ -0,0 +1,166 @@
+// Hamming(8,4) SECDED (packet_fec.h): kimerítő 1 és 2 bithiba teszt minden
+// kódszóra, valamint bithiba beinjektálás - keret kézbesítés BER függvényében,
+// FEC-kel és nélküle (a kézbesítést a CRC16 dönti el, mint a vevőben).
+#include <cstdint>
+#include <cstring>
+#include "test_common.h"
+#include "crc16_ccitt.h"
+#include "packet_fec.h"
+
+typedef Crc16Engine<0x1021, 0xFFFF, 0x0000, false> PacketCrc;
+
+// v1 keret: 5 bájt hasznos adat + CRC16
+static const size_t FRAME_SIZE = 7;
+
+static uint32_t randomState = 12345;
+
+static uint32_t nextRandom() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+static void buildFrame(uint8_t* frame) {
+  for (size_t i = 0; i < FRAME_SIZE - 2; i++) {
+    frame[i] = (uint8_t)nextRandom();
+  }
+  uint16_t crc = PacketCrc::compute(frame, FRAME_SIZE - 2);
+  frame[FRAME_SIZE - 2] = (uint8_t)(crc >> 8);
+  frame[FRAME_SIZE - 1] = (uint8_t)(crc & 0xFF);
+}
+
+static bool frameCrcValid(const uint8_t* frame) {
+  uint16_t crc = PacketCrc::compute(frame, FRAME_SIZE - 2);
+  return frame[FRAME_SIZE - 2] == (uint8_t)(crc >> 8) && frame[FRAME_SIZE - 1] == (uint8_t)(crc & 0xFF);
+}
+
+// Minden bit egymástól függetlenül billen át, ber valószínűséggel
+static void injectBitErrors(uint8_t* data, size_t length, double ber) {
+  const uint32_t threshold = (uint32_t)(ber * 4294967295.0);
+  for (size_t i = 0; i < length; i++) {
+    for (int bit = 0; bit < 8; bit++) {
+      if (nextRandom() < threshold) {
+        data[i] ^= (uint8_t)(1u << bit);
+      }
+    }
+  }
+}
+
+// Egy kódszó dekódolása a keret dekóderen át (1 bájtos keret: alsó + felső félbájt)
+static FecStatus decodePair(uint8_t lowCodeword, uint8_t highCodeword, uint8_t& value, int& corrected) {
+  const uint8_t encoded[2] = {lowCodeword, highCodeword};
+  return PacketFec::decode(encoded, 1, &value, corrected);
+}
+
+static void testExhaustiveCodewords() {
+  const uint8_t cleanHigh = hammingEncodeNibble(0);
+  int singleFailures = 0;
+  int doubleFailures = 0;
+  for (uint8_t nibble = 0; nibble < 16; nibble++) {
+    const uint8_t codeword = hammingEncodeNibble(nibble);
+    uint8_t value = 0;
+    int corrected = -1;
+
+    CHECK(decodePair(codeword, cleanHigh, value, corrected) == FEC_CLEAN && value == nibble && corrected == 0);
+
+    // Minden 1 bithiba javítódik
+    for (int bit = 0; bit < 8; bit++) {
+      FecStatus status = decodePair((uint8_t)(codeword ^ (1u << bit)), cleanHigh, value, corrected);
+      singleFailures += !(status == FEC_CORRECTED && value == nibble && corrected == 1);
+    }
+
+    // Minden 2 bithiba (28 pár) jelzett, soha nem "javított"
+    for (int first = 0; first < 8; first++) {
+      for (int second = first + 1; second < 8; second++) {
+        uint8_t damaged = (uint8_t)(codeword ^ (1u << first) ^ (1u << second));
+        doubleFailures += decodePair(damaged, cleanHigh, value, corrected) != FEC_UNCORRECTABLE;
+      }
+    }
+
+    // Felső félbájt ugyanígy
+    for (int bit = 0; bit < 8; bit++) {
+      FecStatus status = decodePair(hammingEncodeNibble(0), (uint8_t)(codeword ^ (1u << bit)), value, corrected);
+      singleFailures += !(status == FEC_CORRECTED && value == (uint8_t)(nibble << 4) && corrected == 1);
+    }
+  }
+  CHECK(singleFailures == 0);
+  CHECK(doubleFailures == 0);
+}
+
+static void testFrameRoundTrip() {
+  uint8_t frame[FRAME_SIZE];
+  uint8_t encoded[fecEncodedSize(FRAME_SIZE)];
+  uint8_t decoded[FRAME_SIZE];
+  int mismatches = 0;
+  for (int round = 0; round < 1000; round++) {
+    buildFrame(frame);
+    PacketFec::encode(frame, FRAME_SIZE, encoded);
+    int corrected = -1;
+    mismatches += PacketFec::decode(encoded, FRAME_SIZE, decoded, corrected) != FEC_CLEAN ||
+                  corrected != 0 || std::memcmp(frame, decoded, FRAME_SIZE) != 0;
+
+    // Kódszavanként egy bithiba (a teljes keret minden kódszavában): mind javul
+    for (size_t i = 0; i < sizeof(encoded); i++) {
+      encoded[i] ^= (uint8_t)(1u << (nextRandom() & 7));
+    }
+    mismatches += PacketFec::decode(encoded, FRAME_SIZE, decoded, corrected) != FEC_CORRECTED ||
+                  corrected != (int)sizeof(encoded) || std::memcmp(frame, decoded, FRAME_SIZE) != 0;
+  }
+  CHECK(mismatches == 0);
+}
+
+// Kézbesített keretek aránya: a vevő a CRC-t ellenőrzi, FEC-nél előbb dekódol
+// (javíthatatlan kódszónál a keret elvész)
+static void testDeliveryVersusBer() {
+  const int frames = 20000;
+  const double bers[] = {1e-4, 1e-3, 5e-3, 1e-2, 2e-2, 5e-2};
+  double previousPlain = 1.0;
+  double previousFec = 1.0;
+
+  std::printf("  BER       | FEC nélkül | FEC-kel   | hibás elfogadás (FEC)\n");
+  for (double ber : bers) {
+    int plainDelivered = 0;
+    int fecDelivered = 0;
+    int fecFalseAccepts = 0;
+    for (int i = 0; i < frames; i++) {
+      uint8_t frame[FRAME_SIZE];
+      buildFrame(frame);
+
+      uint8_t plain[FRAME_SIZE];
+      std::memcpy(plain, frame, FRAME_SIZE);
+      injectBitErrors(plain, FRAME_SIZE, ber);
+      plainDelivered += frameCrcValid(plain) && std::memcmp(plain, frame, FRAME_SIZE) == 0;
+
+      uint8_t encoded[fecEncodedSize(FRAME_SIZE)];
+      uint8_t decoded[FRAME_SIZE];
+      int corrected = 0;
+      PacketFec::encode(frame, FRAME_SIZE, encoded);
+      injectBitErrors(encoded, sizeof(encoded), ber);
+      if (PacketFec::decode(encoded, FRAME_SIZE, decoded, corrected) != FEC_UNCORRECTABLE &&
+          frameCrcValid(decoded)) {
+        if (std::memcmp(decoded, frame, FRAME_SIZE) == 0) {
+          fecDelivered++;
+        } else {
+          fecFalseAccepts++;
+        }
+      }
+    }
+    double plainRatio = (double)plainDelivered / frames;
+    double fecRatio = (double)fecDelivered / frames;
+    std::printf("  %-9g | %8.2f %% | %7.2f %% | %d\n", ber, 100.0 * plainRatio, 100.0 * fecRatio, fecFalseAccepts);
+
+    CHECK(fecRatio >= plainRatio);
+    CHECK(fecRatio <= previousFec && plainRatio <= previousPlain);
+    CHECK(fecFalseAccepts == 0);
+    previousPlain = plainRatio;
+    previousFec = fecRatio;
+  }
+}
+
+int main() {
+  testExhaustiveCodewords();
+  testFrameRoundTrip();
+  testDeliveryVersusBer();
+  return testExitCode("test_packet_fec");
+}
@@ -0,0 +1,353 @@
+// Saját SX127x meghajtó (sx127x.h) regiszter szintű SPI modellen: a begin /
+// beállítók / vétel / adás regiszter írásai, a státusz blokk és FIFO burst
+// olvasás, valamint műveletenként az SPI tranzakciók, átvitt bájtok, a
+// buszidő (8 MHz) és a meghajtó CPU ideje a gazdagépen.
+#include <cstdint>
+#include <cstring>
+#include "test_common.h"
+#include "sx127x.h"
+
+// ===== REGISZTER SZINTŰ SX127x MODELL =====
+// Regiszter tér + 256 bájtos FIFO (a 0x00 cím a FifoAddrPtr-en át, léptetve),
+// burst hozzáférésnél a cím lép. IRQ jelzők: 1 írása töröl. TX módba
+// kapcsoláskor a TxDone azonnal "megérkezik" (DIO0 él → a meghajtó ISR-je).
+struct RadioModel {
+  uint8_t registers[128];
+  uint8_t fifo[SX127X_FIFO_SIZE];
+  bool completeTx;
+  bool txDoneRaised;
+  long transactions;
+  long interruptTransactions;           // spi_device_transmit (DMA, alvó várakozás)
+  long bytes;                           // Cím bájttal együtt
+
+  void reset() {
+    std::memset(registers, 0, sizeof(registers));
+    std::memset(fifo, 0, sizeof(fifo));
+    registers[SX127X_REG_LNA] = 0x20;
+    registers[SX127X_REG_MODEM_CONFIG_1] = 0x72;
+    registers[SX127X_REG_MODEM_CONFIG_2] = 0x70;
+    registers[SX127X_REG_VERSION] = SX127X_VERSION;
+    completeTx = true;
+    txDoneRaised = false;
+    resetCounters();
+  }
+
+  void resetCounters() {
+    transactions = 0;
+    interruptTransactions = 0;
+    bytes = 0;
+  }
+
+  uint8_t readByte(uint8_t address) {
+    if (address == SX127X_REG_FIFO) {
+      return fifo[registers[SX127X_REG_FIFO_ADDR_PTR]++];
+    }
+    return registers[address];
+  }
+
+  void writeByte(uint8_t address, uint8_t value) {
+    if (address == SX127X_REG_FIFO) {
+      fifo[registers[SX127X_REG_FIFO_ADDR_PTR]++] = value;
+      return;
+    }
+    if (address == SX127X_REG_IRQ_FLAGS) {
+      registers[address] &= (uint8_t)~value;
+      return;
+    }
+    registers[address] = value;
+    if (address == SX127X_REG_OP_MODE && (value & 0x07) == SX127X_MODE_TX && completeTx) {
+      registers[SX127X_REG_IRQ_FLAGS] |= SX127X_IRQ_TX_DONE;
+      registers[SX127X_REG_OP_MODE] = SX127X_MODE_LONG_RANGE | SX127X_MODE_STDBY;
+      txDoneRaised = true;
+    }
+  }
+
+  void transfer(spi_transaction_t* transaction) {
+    bool write = (transaction->addr & 0x80) != 0;
+    uint8_t address = transaction->addr & 0x7F;
+    size_t length = (write ? transaction->length : transaction->rxlength) / 8;
+    const uint8_t* txData = (transaction->flags & SPI_TRANS_USE_TXDATA)
+      ? transaction->tx_data : (const uint8_t*)transaction->tx_buffer;
+    uint8_t* rxData = (transaction->flags & SPI_TRANS_USE_RXDATA)
+      ? transaction->rx_data : (uint8_t*)transaction->rx_buffer;
+
+    transactions++;
+    bytes += 1 + (long)length;
+    for (size_t i = 0; i < length; i++) {
+      if (write) {
+        writeByte(address, txData[i]);
+      } else {
+        rxData[i] = readByte(address);
+      }
+      if (address != SX127X_REG_FIFO) {
+        address++;
+      }
+    }
+
+    // DIO0 felfutó él a tranzakció után (a meghajtó RISING-re figyel)
+    if (txDoneRaised) {
+      txDoneRaised = false;
+      if (stubInterrupt.handler) {
+        stubInterrupt.handler();
+      }
+    }
+  }
+};
+
+static RadioModel model;
+static int attachedDevices = 0;
+
+esp_err_t spi_bus_initialize(spi_host_device_t, const spi_bus_config_t*, int) {
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_free(spi_host_device_t) {
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_add_device(spi_host_device_t, const spi_device_interface_config_t* config,
+                             spi_device_handle_t* handle) {
+  CHECK(config->address_bits == 8);
+  CHECK(config->flags & SPI_DEVICE_HALFDUPLEX);
+  attachedDevices++;
+  *handle = (spi_device_handle_t)&model;
+  return ESP_OK;
+}
+
+esp_err_t spi_bus_remove_device(spi_device_handle_t) {
+  attachedDevices--;
+  return ESP_OK;
+}
+
+esp_err_t spi_device_transmit(spi_device_handle_t, spi_transaction_t* transaction) {
+  model.interruptTransactions++;
+  model.transfer(transaction);
+  return ESP_OK;
+}
+
+esp_err_t spi_device_polling_transmit(spi_device_handle_t, spi_transaction_t* transaction) {
+  model.transfer(transaction);
+  return ESP_OK;
+}
+
+// A meghajtó DMA pufferei miatt statikus tárolás (mint a vázlatokban)
+static Sx127x radio;
+
+static const long FREQUENCY_HZ = 433E6;
+static const uint8_t PACKET[7] = {0x45, 0x12, 0x05, 0x00, 0x01, 0x9C, 0x3E};
+static const uint8_t RX_FIFO_ADDRESS = 0x40;
+
+// Egy vett csomag a modellben: FIFO tartalom + vételi státusz blokk
+static void receivePacket(const uint8_t* data, uint8_t length, uint8_t irqFlags) {
+  std::memcpy(model.fifo + RX_FIFO_ADDRESS, data, length);
+  model.registers[SX127X_REG_FIFO_RX_CURRENT_ADDR] = RX_FIFO_ADDRESS;
+  model.registers[SX127X_REG_IRQ_FLAGS] = irqFlags;
+  model.registers[SX127X_REG_RX_NB_BYTES] = length;
+  model.registers[SX127X_REG_PKT_SNR_VALUE] = (uint8_t)(int8_t)-40;   // -10 dB
+  model.registers[SX127X_REG_PKT_RSSI_VALUE] = 100;
+}
+
+static void testBegin() {
+  model.reset();
+  model.registers[SX127X_REG_VERSION] = 0x00;
+  CHECK(radio.begin(FREQUENCY_HZ) == 0);
+  CHECK(attachedDevices == 0);
+
+  model.reset();
+  CHECK(radio.begin(FREQUENCY_HZ) == 1);
+  CHECK(attachedDevices == 1);
+  CHECK(stubInterrupt.handler != nullptr);
+
+  // 433 MHz: Frf = 433E6 * 2^19 / 32 MHz = 0x6C4000
+  CHECK(model.registers[SX127X_REG_FRF_MSB] == 0x6C);
+  CHECK(model.registers[SX127X_REG_FRF_MSB + 1] == 0x40);
+  CHECK(model.registers[SX127X_REG_FRF_MSB + 2] == 0x00);
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_STDBY));
+  CHECK(model.registers[SX127X_REG_FIFO_TX_BASE_ADDR] == 0);
+  CHECK(model.registers[SX127X_REG_FIFO_RX_BASE_ADDR] == 0);
+  CHECK(model.registers[SX127X_REG_LNA] == 0x23);
+  CHECK(model.registers[SX127X_REG_MODEM_CONFIG_3] == 0x04);
+  CHECK(model.registers[SX127X_REG_OCP] == 0x2B);
+  CHECK(model.registers[SX127X_REG_PA_DAC] == 0x84);
+  CHECK(model.registers[SX127X_REG_PA_CONFIG] == 0x8F);
+}
+
+static void testModemSettings() {
+  radio.setSignalBandwidth(125E3);
+  CHECK((model.registers[SX127X_REG_MODEM_CONFIG_1] >> 4) == 7);
+  radio.setCodingRate4(5);
+  CHECK(((model.registers[SX127X_REG_MODEM_CONFIG_1] >> 1) & 0x07) == 1);
+
+  // SF12 / 125 kHz: 32,8 ms szimbólumidő → alacsony adatsebesség optimalizálás
+  radio.setSpreadingFactor(12);
+  CHECK((model.registers[SX127X_REG_MODEM_CONFIG_2] >> 4) == 12);
+  CHECK(model.registers[SX127X_REG_DETECTION_OPTIMIZE] == 0xC3);
+  CHECK(model.registers[SX127X_REG_DETECTION_THRESHOLD] == 0x0A);
+  CHECK(model.registers[SX127X_REG_MODEM_CONFIG_3] & 0x08);
+  radio.setSpreadingFactor(7);
+  CHECK((model.registers[SX127X_REG_MODEM_CONFIG_2] >> 4) == 7);
+  CHECK(!(model.registers[SX127X_REG_MODEM_CONFIG_3] & 0x08));
+  radio.setSpreadingFactor(6);
+  CHECK(model.registers[SX127X_REG_DETECTION_OPTIMIZE] == 0xC5);
+  CHECK(model.registers[SX127X_REG_DETECTION_THRESHOLD] == 0x0C);
+  radio.setSpreadingFactor(7);
+
+  radio.setPreambleLength(8);
+  CHECK(model.registers[SX127X_REG_PREAMBLE_MSB] == 0 && model.registers[SX127X_REG_PREAMBLE_MSB + 1] == 8);
+  radio.enableCrc();
+  CHECK(model.registers[SX127X_REG_MODEM_CONFIG_2] & 0x04);
+  radio.disableCrc();
+  CHECK(!(model.registers[SX127X_REG_MODEM_CONFIG_2] & 0x04));
+  radio.enableCrc();
+  radio.setSyncWord(0x34);
+  CHECK(model.registers[SX127X_REG_SYNC_WORD] == 0x34);
+}
+
+static void testReceive() {
+  radio.receive();
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_RX_CONTINUOUS));
+  CHECK(model.registers[SX127X_REG_DIO_MAPPING_1] == SX127X_DIO0_RX_DONE);
+  CHECK(!(model.registers[SX127X_REG_MODEM_CONFIG_1] & 0x01));
+
+  // Ugyanarra a beállításra nincs regiszter írás
+  model.resetCounters();
+  radio.receive();
+  CHECK(model.transactions == 0);
+
+  // Implicit fejléc: hossz regiszter, majd vissza explicitre
+  radio.receive(sizeof(PACKET));
+  CHECK(model.registers[SX127X_REG_MODEM_CONFIG_1] & 0x01);
+  CHECK(model.registers[SX127X_REG_PAYLOAD_LENGTH] == sizeof(PACKET));
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_RX_CONTINUOUS));
+  radio.receive();
+  CHECK(!(model.registers[SX127X_REG_MODEM_CONFIG_1] & 0x01));
+
+  // Nincs csomag: egyetlen státusz blokk olvasás
+  uint8_t buffer[SX127X_FIFO_SIZE];
+  int rssi = 0;
+  float snr = 0;
+  model.resetCounters();
+  CHECK(radio.readPacket(buffer, sizeof(buffer), rssi, snr) == 0);
+  CHECK(model.transactions == 1);
+
+  // Csomag: státusz blokk + IRQ törlés + FIFO cím + FIFO burst
+  receivePacket(PACKET, sizeof(PACKET), SX127X_IRQ_RX_DONE);
+  model.resetCounters();
+  CHECK(radio.readPacket(buffer, sizeof(buffer), rssi, snr) == (int)sizeof(PACKET));
+  CHECK(std::memcmp(buffer, PACKET, sizeof(PACKET)) == 0);
+  CHECK(model.transactions == 4);
+  CHECK(model.registers[SX127X_REG_IRQ_FLAGS] == 0);
+  CHECK(rssi == 100 - SX127X_RSSI_OFFSET_LF);
+  CHECK(snr == -10.0f);
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_RX_CONTINUOUS));
+
+  // Kis kapacitás: csak a befér, a visszatérés a teljes méret
+  receivePacket(PACKET, sizeof(PACKET), SX127X_IRQ_RX_DONE);
+  uint8_t small[3] = {0, 0, 0};
+  CHECK(radio.readPacket(small, sizeof(small), rssi, snr) == (int)sizeof(PACKET));
+  CHECK(std::memcmp(small, PACKET, sizeof(small)) == 0);
+
+  // CRC hiba: eldobva, számolva, jelzők törölve
+  receivePacket(PACKET, sizeof(PACKET), SX127X_IRQ_RX_DONE | SX127X_IRQ_PAYLOAD_CRC_ERROR);
+  CHECK(radio.readPacket(buffer, sizeof(buffer), rssi, snr) == 0);
+  CHECK(radio.getCrcErrors() == 1);
+  CHECK(model.registers[SX127X_REG_IRQ_FLAGS] == 0);
+
+  // LoRa könyvtár kompatibilis út
+  receivePacket(PACKET, sizeof(PACKET), SX127X_IRQ_RX_DONE);
+  CHECK(radio.parsePacket() == (int)sizeof(PACKET));
+  CHECK(radio.available() == (int)sizeof(PACKET));
+  int mismatches = 0;
+  for (size_t i = 0; i < sizeof(PACKET); i++) {
+    mismatches += radio.read() != PACKET[i];
+  }
+  CHECK(mismatches == 0);
+  CHECK(radio.read() == -1);
+  CHECK(radio.packetRssi() == 100 - SX127X_RSSI_OFFSET_LF);
+}
+
+static void testTransmit() {
+  CHECK(radio.beginPacket() == 1);
+  CHECK(radio.write(PACKET, sizeof(PACKET)) == sizeof(PACKET));
+  CHECK(radio.endPacket() == 1);
+  CHECK(std::memcmp(model.fifo, PACKET, sizeof(PACKET)) == 0);
+  CHECK(model.registers[SX127X_REG_PAYLOAD_LENGTH] == sizeof(PACKET));
+  CHECK(model.registers[SX127X_REG_DIO_MAPPING_1] == SX127X_DIO0_RX_DONE);
+  CHECK(model.registers[SX127X_REG_IRQ_FLAGS] == 0);
+  CHECK(radio.getTxTimeouts() == 0);
+
+  // Adás után a receive() újra vételre kapcsol
+  radio.receive();
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_RX_CONTINUOUS));
+
+  // Elmaradó TxDone: időtúllépés, készenlét
+  model.completeTx = false;
+  radio.beginPacket();
+  radio.write(PACKET, sizeof(PACKET));
+  CHECK(radio.endPacket() == 0);
+  CHECK(radio.getTxTimeouts() == 1);
+  CHECK(model.registers[SX127X_REG_OP_MODE] == (SX127X_MODE_LONG_RANGE | SX127X_MODE_STDBY));
+  model.completeTx = true;
+
+  // A FIFO-nál nagyobb csomag levágva
+  uint8_t large[300] = {};
+  radio.beginPacket();
+  CHECK(radio.write(large, sizeof(large)) == (size_t)SX127X_MAX_PAYLOAD);
+}
+
+// Műveletenként: SPI tranzakciók, bájtok, buszidő 8 MHz-en és CPU idő
+template <typename Operation>
+static void measureOperation(const char* name, Operation operation) {
+  model.resetCounters();
+  operation();
+  long transactions = model.transactions;
+  long interruptTransactions = model.interruptTransactions;
+  long bytes = model.bytes;
+  double busMicros = bytes * 8.0 / SX127X_SPI_CLOCK_HZ * 1e6;
+  double cpuNs = benchmarkNs(200000, [&](long) { operation(); });
+  std::printf("  %-22s | %2ld (%ld DMA) | %4ld | %6.1f µs | %7.1f ns\n",
+              name, transactions, interruptTransactions, bytes, busMicros, cpuNs);
+}
+
+static void benchmarkOperations() {
+  uint8_t buffer[SX127X_FIFO_SIZE];
+  int rssi = 0;
+  float snr = 0;
+  uint8_t fullFifo[SX127X_MAX_PAYLOAD];
+  std::memset(fullFifo, 0x5A, sizeof(fullFifo));
+
+  radio.receive();
+  std::printf("  művelet                | tranzakció | bájt | busz 8 MHz | CPU (gazdagép)\n");
+  measureOperation("receive() 2x", [&]() { radio.receive(); });
+  measureOperation("readPacket (nincs)", [&]() {
+    model.registers[SX127X_REG_IRQ_FLAGS] = 0;
+    radio.readPacket(buffer, sizeof(buffer), rssi, snr);
+  });
+  measureOperation("readPacket 7 B", [&]() {
+    receivePacket(PACKET, sizeof(PACKET), SX127X_IRQ_RX_DONE);
+    radio.readPacket(buffer, sizeof(buffer), rssi, snr);
+  });
+  measureOperation("readPacket 64 B", [&]() {
+    receivePacket(fullFifo, 64, SX127X_IRQ_RX_DONE);
+    radio.readPacket(buffer, sizeof(buffer), rssi, snr);
+  });
+  measureOperation("endPacket 7 B", [&]() {
+    radio.beginPacket();
+    radio.write(PACKET, sizeof(PACKET));
+    radio.endPacket();
+  });
+  measureOperation("setSpreadingFactor", [&]() { radio.setSpreadingFactor(7); });
+}
+
+int main() {
+  testBegin();
+  testModemSettings();
+  testReceive();
+  testTransmit();
+  benchmarkOperations();
+
+  radio.end();
+  CHECK(attachedDevices == 0);
+  CHECK(stubInterrupt.handler == nullptr);
+  return testExitCode("test_sx127x");
+}
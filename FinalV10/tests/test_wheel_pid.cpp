@@ -0,0 +1,210 @@
+// Kerék PID (wheel_pid.h) egy elsőrendű DC motor modellen: az alapértelmezett
+// WHEEL_PID_KP / WHEEL_PID_KI ugrásválasza, anti-windup telítésnél, nullázás
+// 0 célnál és a tisztán előrecsatolt (kp = ki = 0) állandósult állapot.
+#include <cmath>
+#include <initializer_list>
+#include "test_common.h"
+#include "settings.h"
+#include "wheel_pid.h"
+
+static const double SIMULATION_STEP = 0.001;
+static const int STEPS_PER_UPDATE = (int)(1.0 / (WHEEL_PID_HZ * SIMULATION_STEP));
+
+// DC motor: elsőrendű (tau időállandó) fordulatszám, a kitöltéssel és az
+// akkumulátor feszültséggel arányos végsebesség, egész impulzusra kvantált enkóder
+struct MotorModel {
+  double gain;                 // Motor szórás (1 = névleges)
+  double battery;              // Relatív akkumulátor feszültség
+  double freeCps;              // Végsebesség 255 kitöltésnél, névleges feszültségen
+  double tau;
+  double speed;
+  double position;
+  long counted;
+
+  MotorModel(double gain, double battery, double freeCps)
+    : gain(gain), battery(battery), freeCps(freeCps), tau(0.12), speed(0), position(0), counted(0) {}
+
+  void step(double duty) {
+    double steadySpeed = gain * battery * freeCps * duty / 255.0;
+    speed += (steadySpeed - speed) * SIMULATION_STEP / tau;
+    position += speed * SIMULATION_STEP;
+  }
+
+  // A PID ütem mérése: az előző olvasás óta számolt impulzus / s
+  double readCps() {
+    long count = (long)std::floor(position);
+    long delta = count - counted;
+    counted = count;
+    return delta * WHEEL_PID_HZ;
+  }
+};
+
+static WheelPidConfig pidConfig(float kp, float ki, float integralLimit = WHEEL_PID_INTEGRAL_LIMIT) {
+  WheelPidConfig config;
+  config.kp = kp;
+  config.ki = ki;
+  config.kd = 0;
+  config.feedForward = (float)(255.0 / WHEEL_MAX_SPEED_CPS);
+  config.outputLimit = 255.0f;
+  config.integralLimit = integralLimit;
+  config.periodSeconds = (float)(1.0 / WHEEL_PID_HZ);
+  return config;
+}
+
+struct StepResult {
+  double riseSeconds;          // 90%-ig
+  double overshootPercent;
+  double finalErrorPercent;    // 3 s után
+};
+
+// closedLoop = false: nyílt hurok, kitöltés = cél * 255 / MAX (a korábbi viselkedés)
+static StepResult runStep(MotorModel motor, double targetCps, bool closedLoop, const WheelPidConfig& config) {
+  WheelPid pid(config);
+  double duty = 0;
+  double peak = 0;
+  double rise = -1;
+  for (int i = 0; i < 3000; i++) {
+    if (i % STEPS_PER_UPDATE == 0) {
+      double measured = motor.readCps();
+      duty = closedLoop ? pid.update((float)targetCps, (float)measured) : targetCps * 255.0 / WHEEL_MAX_SPEED_CPS;
+    }
+    motor.step(duty);
+    peak = std::fmax(peak, motor.speed);
+    if (rise < 0 && motor.speed >= 0.9 * targetCps) {
+      rise = (i + 1) * SIMULATION_STEP;
+    }
+  }
+  return StepResult{rise, (peak - targetCps) / targetCps * 100, (motor.speed - targetCps) / targetCps * 100};
+}
+
+// Összehasonlításhoz: ugyanaz a PI, integrátor korlát és feltételes integrálás nélkül
+struct NaivePi {
+  double integral = 0;
+
+  double update(double target, double measured) {
+    double error = target - measured;
+    integral += WHEEL_PID_KI * error / WHEEL_PID_HZ;
+    double output = 255.0 / WHEEL_MAX_SPEED_CPS * target + WHEEL_PID_KP * error + integral;
+    return output > 255 ? 255 : (output < -255 ? -255 : output);
+  }
+};
+
+// Gyenge motor, lemerült akku: 2 s elérhetetlen cél (telítés), majd 800 imp/s.
+// Visszatér: az utolsó időpont (ms a célváltás után), amikor a hiba ±5% felett volt.
+// worstOvershoot: a legnagyobb túllövés 300 ms után (addig a motor lassul)
+static int runWindup(bool antiWindup, double& worstOvershoot) {
+  MotorModel motor(0.85, 0.7, 2400);
+  WheelPid pid(pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  NaivePi naive;
+  double duty = 0;
+  int lastOutside = -1;
+  worstOvershoot = 0;
+  for (int i = 0; i < 4000; i++) {
+    double target = i < 2000 ? 2000 : 800;
+    if (i % STEPS_PER_UPDATE == 0) {
+      double measured = motor.readCps();
+      duty = antiWindup ? pid.update((float)target, (float)measured) : naive.update(target, measured);
+    }
+    motor.step(duty);
+    if (i >= 2000) {
+      double error = motor.speed - 800;
+      if (i >= 2300) {
+        worstOvershoot = std::fmax(worstOvershoot, error);
+      }
+      if (std::fabs(error) >= 0.05 * 800) {
+        lastOutside = i - 2000;
+      }
+    }
+  }
+  return lastOutside;
+}
+
+static void testDefaultGains() {
+  // Szórásos motor (0.85x) és 0.8-as akku: nyílt hurokban jelentős a lemaradás
+  MotorModel weak(0.85, 0.8, 2400);
+  StepResult open = runStep(weak, 1200, false, pidConfig(0, 0));
+  StepResult closed = runStep(weak, 1200, true, pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  std::printf("  ugrás 1200 imp/s (0.85x, akku 0.8): nyílt %.1f%% | zárt %.1f%%, emelkedés %.3f s, túllövés %.1f%%\n",
+              open.finalErrorPercent, closed.finalErrorPercent, closed.riseSeconds, closed.overshootPercent);
+  CHECK(std::fabs(open.finalErrorPercent) > 10);
+  CHECK(std::fabs(closed.finalErrorPercent) < 1);
+  CHECK(closed.riseSeconds > 0 && closed.riseSeconds < 0.5);
+  CHECK(closed.overshootPercent < 10);
+
+  // Erős motor, teli akku: a PID lefelé is korrigál
+  MotorModel strong(1.0, 1.0, 2400);
+  closed = runStep(strong, 1200, true, pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  std::printf("  ugrás 1200 imp/s (1.0x, akku 1.0): zárt %.1f%%, túllövés %.1f%%\n",
+              closed.finalErrorPercent, closed.overshootPercent);
+  CHECK(std::fabs(closed.finalErrorPercent) < 1);
+  CHECK(closed.overshootPercent < 20);
+}
+
+static void testAntiWindup() {
+  double antiWindupOvershoot = 0;
+  double naiveOvershoot = 0;
+  int antiWindupSettle = runWindup(true, antiWindupOvershoot);
+  int naiveSettle = runWindup(false, naiveOvershoot);
+  std::printf("  telítés 2000 → 800 imp/s: anti-windup beáll %d ms (túllövés %.0f) | naiv %d ms (túllövés %.0f)\n",
+              antiWindupSettle, antiWindupOvershoot, naiveSettle, naiveOvershoot);
+  CHECK(antiWindupSettle >= 0 && antiWindupSettle < 1200);
+  // A naiv integrátor a mérés végéig (2 s) sem áll be
+  CHECK(naiveSettle > 1900);
+  CHECK(antiWindupOvershoot < 0.05 * 800);
+  CHECK(naiveOvershoot > 0.5 * 800);
+
+  // Tartós telítés: a kimenet a határon, az integrátor nem nő a korlát fölé
+  WheelPid pid(pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  for (int i = 0; i < 500; i++) {
+    CHECK(pid.update(2000, 500) == 255.0f);
+  }
+  CHECK(pid.isSaturated());
+  CHECK(pid.getIntegral() <= WHEEL_PID_INTEGRAL_LIMIT);
+
+  // A korlát magában is hat (telítetlen, de tartós hiba)
+  WheelPid limited(pidConfig(0, 10.0f, 20.0f));
+  for (int i = 0; i < 500; i++) {
+    limited.update(100, 0);
+  }
+  CHECK(limited.getIntegral() == 20.0f);
+  CHECK(!limited.isSaturated());
+}
+
+static void testZeroTargetReset() {
+  WheelPid pid(pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  for (int i = 0; i < 100; i++) {
+    pid.update(1000, 900);
+  }
+  CHECK(pid.getIntegral() > 0);
+  // A WheelSpeedControl 0 célnál így indít tiszta lappal
+  pid.reset(150);
+  CHECK(pid.getIntegral() == 0);
+  CHECK(!pid.isSaturated());
+  // Nullázás után az első lépés csak előrecsatolás + P
+  float output = pid.update(1000, 1000);
+  CHECK(std::fabs(output - (float)(1000 * 255.0 / WHEEL_MAX_SPEED_CPS)) < 0.01f);
+}
+
+static void testFeedForwardOnly() {
+  // Névleges motor (végsebesség = WHEEL_MAX_SPEED_CPS): az előrecsatolás magában célba visz
+  for (double target : {400.0, 1200.0, 2000.0}) {
+    StepResult result = runStep(MotorModel(1.0, 1.0, WHEEL_MAX_SPEED_CPS), target, true, pidConfig(0, 0));
+    CHECK(std::fabs(result.finalErrorPercent) < 0.5);
+    CHECK(result.overshootPercent < 0.5);
+  }
+}
+
+int main() {
+  testDefaultGains();
+  testAntiWindup();
+  testZeroTargetReset();
+  testFeedForwardOnly();
+
+  WheelPid pid(pidConfig(WHEEL_PID_KP, WHEEL_PID_KI));
+  double updateNs = benchmarkNs(10000000, [&](long i) {
+    benchmarkSink += (unsigned long)pid.update(1000.0f, (float)(i & 1023));
+  });
+  std::printf("  WheelPid::update: %.2f ns/hívás\n", updateNs);
+
+  return testExitCode("test_wheel_pid");
+}